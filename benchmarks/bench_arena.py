@@ -0,0 +1,68 @@
+"""Times a draw loop that creates Path, Paint and Matrix objects per iteration
+against the same loop using skia.Arena.
+
+Usage::
+
+    python benchmarks/bench_arena.py [iterations]
+"""
+import sys
+import time
+
+import skia
+
+
+def fresh(canvas, count):
+    for i in range(count):
+        matrix = skia.Matrix()
+        matrix.setTranslate(i % 64, i % 48)
+        path = skia.Path()
+        path.addRect(skia.Rect(4, 4))
+        paint = skia.Paint(Color=0xFF000000 | i & 0xFFFFFF)
+        canvas.save()
+        canvas.concat(matrix)
+        canvas.drawPath(path, paint)
+        canvas.restore()
+
+
+def arena(canvas, count):
+    arena = skia.Arena()
+    for i in range(count):
+        with arena:
+            matrix = arena.Matrix()
+            matrix.setTranslate(i % 64, i % 48)
+            path = arena.Path()
+            path.addRect(skia.Rect(4, 4))
+            paint = arena.Paint(Color=0xFF000000 | i & 0xFFFFFF)
+            canvas.save()
+            canvas.concat(matrix)
+            canvas.drawPath(path, paint)
+            canvas.restore()
+
+
+def hoisted(canvas, count):
+    matrix, path, paint = skia.Matrix(), skia.Path(), skia.Paint()
+    for i in range(count):
+        matrix.setTranslate(i % 64, i % 48)
+        path.rewind()
+        path.addRect(skia.Rect(4, 4))
+        paint.setColor(0xFF000000 | i & 0xFFFFFF)
+        canvas.save()
+        canvas.concat(matrix)
+        canvas.drawPath(path, paint)
+        canvas.restore()
+
+
+def main(count):
+    surface = skia.Surface(64, 48)
+    canvas = surface.getCanvas()
+    for name, fn in [('new objects', fresh), ('skia.Arena', arena),
+                     ('hoisted objects', hoisted)]:
+        start = time.perf_counter()
+        fn(canvas, count)
+        elapsed = time.perf_counter() - start
+        print('%-16s %8.3f s  %6.2f us/iteration' % (
+            name, elapsed, elapsed / count * 1e6))
+
+
+if __name__ == '__main__':
+    main(int(sys.argv[1]) if len(sys.argv) > 1 else 1000000)
@@ -0,0 +1,59 @@
+"""Times Pixmap.convertTo per color/alpha type pair against Image.convert.
+
+Usage::
+
+    python benchmarks/bench_convert.py [width height]
+"""
+import sys
+import timeit
+
+import numpy as np
+import skia
+
+
+PAIRS = [
+    ((skia.kRGBA_8888_ColorType, skia.kUnpremul_AlphaType),
+     (skia.kRGBA_8888_ColorType, skia.kPremul_AlphaType), np.uint8),
+    ((skia.kRGBA_8888_ColorType, skia.kPremul_AlphaType),
+     (skia.kBGRA_8888_ColorType, skia.kPremul_AlphaType), np.uint8),
+    ((skia.kRGBA_8888_ColorType, skia.kPremul_AlphaType),
+     (skia.kRGBA_F16_ColorType, skia.kPremul_AlphaType), np.float16),
+    ((skia.kRGBA_8888_ColorType, skia.kUnpremul_AlphaType),
+     (skia.kRGBA_F32_ColorType, skia.kPremul_AlphaType), np.float32),
+    ((skia.kRGBA_F16_ColorType, skia.kPremul_AlphaType),
+     (skia.kRGBA_8888_ColorType, skia.kUnpremul_AlphaType), np.uint8),
+]
+
+
+def best(fn):
+    fn()
+    return min(timeit.repeat(fn, number=1, repeat=5)) * 1e3
+
+
+def main(width, height):
+    rng = np.random.default_rng(0)
+    for (src_ct, src_at), (dst_ct, dst_at), dtype in PAIRS:
+        src = np.empty((height, width, 4),
+                       np.float16 if src_ct == skia.kRGBA_F16_ColorType
+                       else np.uint8)
+        src[...] = rng.integers(0, 255, src.shape)
+        if src.dtype == np.float16:
+            src /= 255
+        image = skia.Image.fromarray(src, src_ct, src_at)
+        pixmap = skia.Pixmap(src, src_ct, src_at)
+        dst = np.empty((height, width, 4), dtype)
+
+        name = '%s/%s -> %s/%s' % (src_ct.name, src_at.name,
+                                   dst_ct.name, dst_at.name)
+        print(name)
+        print('  Image.convert           %8.2f ms' % best(
+            lambda: image.convert(dst_ct, dst_at)))
+        for threads in (1, 0):
+            print('  Pixmap.convertTo(t=%d)   %8.2f ms' % (threads, best(
+                lambda: pixmap.convertTo(dst, dst_ct, dst_at,
+                                         threads=threads))))
+
+
+if __name__ == '__main__':
+    size = [int(v) for v in sys.argv[1:3]] or [4096, 4096]
+    main(*size)
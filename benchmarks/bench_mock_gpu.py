@@ -0,0 +1,197 @@
+"""Runs representative scenes through a mock GPU context and reports GPU ops,
+flushes, resource cache usage and CPU time per frame.
+
+The mock backend runs Skia's GPU code path, including op batching and resource
+allocation, without drawing anything, so GPU-path regressions show up on
+machines without a GPU. Op and flush counts come from ``skia.tracing`` and are
+0 when Skia is built without tracing.
+
+Usage::
+
+    python benchmarks/bench_mock_gpu.py [--frames N] [--json out.json]
+        [--baseline baseline.json] [--tolerance 0.25]
+
+With ``--baseline``, exits with status 1 when a scene executes more ops or
+flushes than in the baseline, or its CPU time grows by more than the tolerance.
+"""
+import argparse
+import json
+import statistics
+import sys
+import time
+
+import numpy as np
+import skia
+
+
+WIDTH, HEIGHT = 1024, 768
+
+
+def make_rects(rng):
+    rects = rng.uniform(0, [WIDTH, HEIGHT, 64, 64], (2000, 4))
+    colors = rng.integers(0xFF000000, 0xFFFFFFFF, len(rects), dtype=np.uint32)
+    rects = [skia.Rect.MakeXYWH(*r) for r in rects.tolist()]
+    paints = [skia.Paint(Color=int(c)) for c in colors]
+
+    def draw(canvas):
+        for rect, paint in zip(rects, paints):
+            canvas.drawRect(rect, paint)
+    return draw
+
+
+def make_text(rng):
+    font = skia.Font(skia.Typeface(''), 14)
+    paint = skia.Paint(AntiAlias=True)
+    lines = ['Line %d: the quick brown fox jumps over the lazy dog' % i
+             for i in range(200)]
+    origins = rng.uniform(0, [WIDTH / 2, HEIGHT], (len(lines), 2)).tolist()
+
+    def draw(canvas):
+        for text, (x, y) in zip(lines, origins):
+            canvas.drawString(text, x, y, font, paint)
+    return draw
+
+
+def make_paths(rng):
+    paths = []
+    for _ in range(200):
+        x, y = rng.uniform(0, [WIDTH, HEIGHT])
+        points = rng.uniform(-40, 40, (6, 2)) + [x, y]
+        path = skia.Path()
+        path.moveTo(*points[0])
+        path.cubicTo(*points[1], *points[2], *points[3])
+        path.quadTo(*points[4], *points[5])
+        path.close()
+        paths.append(path)
+    fill = skia.Paint(AntiAlias=True, Color=0xFF3366CC)
+    stroke = skia.Paint(AntiAlias=True, Color=0xFFCC3333,
+                        Style=skia.Paint.kStroke_Style, StrokeWidth=3)
+
+    def draw(canvas):
+        for path in paths:
+            canvas.drawPath(path, fill)
+            canvas.drawPath(path, stroke)
+    return draw
+
+
+def make_images(rng):
+    images = [
+        skia.Image.fromarray(rng.integers(0, 255, (64, 64, 4), dtype=np.uint8))
+        for _ in range(16)]
+    rects = [skia.Rect.MakeXYWH(*r) for r in
+             rng.uniform(0, [WIDTH, HEIGHT, 128, 128], (500, 4)).tolist()]
+    sampling = skia.SamplingOptions(skia.FilterMode.kLinear)
+
+    def draw(canvas):
+        for i, rect in enumerate(rects):
+            canvas.drawImageRect(images[i % len(images)], rect, sampling)
+    return draw
+
+
+SCENES = [
+    ('rects', make_rects),
+    ('text', make_text),
+    ('paths', make_paths),
+    ('images', make_images),
+]
+
+
+def is_op(event):
+    return event['cat'] == 'skia.gpu' and event['name'].endswith('Op')
+
+
+def is_flush(event):
+    return 'DrawingManager' in event['name'] and 'flush' in event['name']
+
+
+def render(context, surface, draw):
+    canvas = surface.getCanvas()
+    canvas.clear(skia.ColorWHITE)
+    draw(canvas)
+    context.flushAndSubmit()
+
+
+def count_events(context, surface, draw):
+    try:
+        skia.tracing.start(['skia.gpu'])
+    except RuntimeError:
+        return 0, 0
+    render(context, surface, draw)
+    events = json.loads(skia.tracing.stop())['traceEvents']
+    return (sum(is_op(event) for event in events),
+            sum(is_flush(event) for event in events))
+
+
+def run_scene(name, make, frames):
+    context = skia.GrDirectContext.MakeMock(skia.GrMockOptions())
+    info = skia.ImageInfo.Make(
+        WIDTH, HEIGHT, skia.kRGBA_8888_ColorType, skia.kPremul_AlphaType)
+    surface = skia.Surface.MakeRenderTarget(context, skia.Budgeted.kYes, info)
+    draw = make(np.random.default_rng(0))
+
+    render(context, surface, draw)
+    cpu = []
+    for _ in range(frames):
+        start = time.process_time()
+        render(context, surface, draw)
+        cpu.append(time.process_time() - start)
+    ops, flushes = count_events(context, surface, draw)
+    resources, resource_bytes = context.getResourceCacheUsage()
+    return {
+        'scene': name,
+        'ops': ops,
+        'flushes': flushes,
+        'resources': resources,
+        'resourceBytes': resource_bytes,
+        'cpuMs': statistics.median(cpu) * 1e3,
+    }
+
+
+def regressions(results, baseline, tolerance):
+    baseline = {result['scene']: result for result in baseline}
+    found = []
+    for result in results:
+        base = baseline.get(result['scene'])
+        if base is None:
+            continue
+        for key in ('ops', 'flushes'):
+            if result[key] > base[key]:
+                found.append('%s: %s %d > %d' % (
+                    result['scene'], key, result[key], base[key]))
+        if result['cpuMs'] > base['cpuMs'] * (1 + tolerance):
+            found.append('%s: cpuMs %.2f > %.2f' % (
+                result['scene'], result['cpuMs'], base['cpuMs']))
+    return found
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split('\n')[0])
+    parser.add_argument('--frames', type=int, default=20)
+    parser.add_argument('--json', help='write results to this file')
+    parser.add_argument('--baseline', help='compare against this file')
+    parser.add_argument('--tolerance', type=float, default=0.25,
+                        help='allowed relative CPU time growth')
+    args = parser.parse_args()
+
+    results = [run_scene(name, make, args.frames) for name, make in SCENES]
+    print('%-8s %6s %8s %10s %12s %10s' % (
+        'scene', 'ops', 'flushes', 'resources', 'bytes', 'cpu ms'))
+    for r in results:
+        print('%-8s %6d %8d %10d %12d %10.2f' % (
+            r['scene'], r['ops'], r['flushes'], r['resources'],
+            r['resourceBytes'], r['cpuMs']))
+
+    if args.json:
+        with open(args.json, 'w') as f:
+            json.dump(results, f, indent=2)
+    if args.baseline:
+        with open(args.baseline) as f:
+            found = regressions(results, json.load(f), args.tolerance)
+        for line in found:
+            print('REGRESSION', line)
+        return 1 if found else 0
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,75 @@
+"""Compares op counts and playback time of pictures before and after
+Picture.optimize.
+
+The scene mimics pictures recorded from Python drawing code: many small nested
+pictures, save/restore pairs around nothing, and draws outside the clip.
+
+Usage::
+
+    python benchmarks/bench_picture_optimize.py [num_tiles]
+"""
+import sys
+import timeit
+
+import skia
+
+
+def make_symbol():
+    recorder = skia.PictureRecorder()
+    canvas = recorder.beginRecording(skia.Rect(16, 16))
+    paint = skia.Paint(AntiAlias=True)
+    for i, color in enumerate([0xFF3366CC, 0xFFCC3333, 0xFF33CC66]):
+        canvas.save()
+        paint.setColor(color)
+        canvas.drawCircle(8, 8, 8 - i * 2, paint)
+        canvas.restore()
+    return recorder.finishRecordingAsPicture()
+
+
+def make_picture(count):
+    symbol = make_symbol()
+    recorder = skia.PictureRecorder()
+    canvas = recorder.beginRecording(skia.Rect(1024, 1024))
+    paint = skia.Paint()
+    for i in range(count):
+        x, y = (i * 37) % 1100 - 40, (i * 53) % 1100 - 40
+        canvas.save()
+        canvas.translate(x, y)
+        canvas.drawPicture(symbol)
+        canvas.restore()
+        canvas.save()
+        canvas.restore()
+        canvas.save()
+        canvas.clipRect(skia.Rect(0, 0, 8, 8))
+        canvas.drawRect(skia.Rect.MakeXYWH(x, y, 16, 16), paint)
+        canvas.restore()
+    return recorder.finishRecordingAsPicture()
+
+
+def playback_ms(picture, surface):
+    canvas = surface.getCanvas()
+
+    def fn():
+        canvas.drawPicture(picture)
+        surface.flushAndSubmit()
+    fn()
+    return min(timeit.repeat(fn, number=1, repeat=10)) * 1e3
+
+
+def main(count):
+    surface = skia.Surface(1024, 1024)
+    picture = make_picture(count)
+    optimize_ms = min(timeit.repeat(
+        lambda: picture.optimize(), number=1, repeat=5)) * 1e3
+    optimized = picture.optimize()
+
+    print('%-10s %10s %10s %12s' % ('', 'ops', 'bytes', 'playback ms'))
+    for name, p in [('original', picture), ('optimized', optimized)]:
+        print('%-10s %10d %10d %12.2f' % (
+            name, p.approximateOpCount(True), p.approximateBytesUsed(),
+            playback_ms(p, surface)))
+    print('optimize() took %.2f ms (%d tiles)' % (optimize_ms, count))
+
+
+if __name__ == '__main__':
+    main(int(sys.argv[1]) if len(sys.argv) > 1 else 10000)
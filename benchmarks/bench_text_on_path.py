@@ -0,0 +1,51 @@
+"""Compares per-label drawTextOnPath with batched drawTextOnPaths.
+
+Usage::
+
+    python benchmarks/bench_text_on_path.py [num_labels]
+"""
+import sys
+import timeit
+
+import skia
+
+
+def make_labels(count):
+    paths = []
+    for i in range(64):
+        path = skia.Path()
+        path.moveTo(10, 20 + i * 8)
+        path.cubicTo(200, i * 8, 400, 40 + i * 8, 1000, 20 + i * 8)
+        paths.append(path)
+    return [('Road %d' % i, paths[i % len(paths)], (i % 7) * 10.)
+            for i in range(count)]
+
+
+def main(count):
+    surface = skia.Surface(1024, 600)
+    canvas = surface.getCanvas()
+    font = skia.Font(skia.Typeface(''), 10)
+    paint = skia.Paint(AntiAlias=True)
+    labels = make_labels(count)
+
+    def single():
+        for text, path, offset in labels:
+            canvas.drawTextOnPath(
+                text, path, skia.Matrix.Translate(offset, 0), font, paint)
+
+    def batched_warp():
+        canvas.drawTextOnPaths(labels, font, paint, warp=True)
+
+    def batched_rsxform():
+        canvas.drawTextOnPaths(labels, font, paint)
+
+    for name, fn in [('drawTextOnPath', single),
+                     ('drawTextOnPaths(warp=True)', batched_warp),
+                     ('drawTextOnPaths', batched_rsxform)]:
+        fn()
+        elapsed = min(timeit.repeat(fn, number=1, repeat=5))
+        print('%-28s %8.2f ms (%d labels)' % (name, elapsed * 1e3, count))
+
+
+if __name__ == '__main__':
+    main(int(sys.argv[1]) if len(sys.argv) > 1 else 5000)
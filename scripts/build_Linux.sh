@@ -26,6 +26,7 @@ cd skia && \
     gn gen out/Release --args="
 is_official_build=true
 skia_enable_svg=true
+skia_disable_tracing=false
 skia_use_vulkan=true
 skia_use_system_libjpeg_turbo=false
 skia_use_system_libwebp=false
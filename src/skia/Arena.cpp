@@ -0,0 +1,157 @@
+#include "common.h"
+#include <array>
+#include <vector>
+
+namespace {
+
+// Hands out Path, Paint and Matrix objects from slots that are reset instead
+// of reallocated. Slots are reused from the start after reset(), or from
+// where an enclosing scope left off when a nested scope exits. The arena
+// keeps a reference to every object, so reuse never frees memory that Python
+// still points to; stale references only see the object reset.
+class Arena {
+public:
+    py::object path() {
+        checkScope();
+        return next(fPaths, fPathCount, [] (SkPath& path) { path.rewind(); });
+    }
+
+    py::object paint(py::kwargs kwargs) {
+        checkScope();
+        // Parse first, so invalid attributes do not use up a slot.
+        SkPaint value = kwargs.empty() ? SkPaint() : PaintFromDict(kwargs);
+        return next(fPaints, fPaintCount,
+                    [&value] (SkPaint& paint) { paint = std::move(value); });
+    }
+
+    py::object matrix() {
+        checkScope();
+        return next(fMatrices, fMatrixCount,
+                    [] (SkMatrix& matrix) { matrix.reset(); });
+    }
+
+    void reset() { fPathCount = fPaintCount = fMatrixCount = 0; }
+
+    // Nested scopes take slots after those of enclosing scopes, and give them
+    // back on exit.
+    void enter() {
+        fScopes.push_back({ fPathCount, fPaintCount, fMatrixCount });
+    }
+
+    void exit() {
+        if (fScopes.empty())
+            return;
+        const auto& counts = fScopes.back();
+        fPathCount = counts[0];
+        fPaintCount = counts[1];
+        fMatrixCount = counts[2];
+        fScopes.pop_back();
+    }
+
+    size_t capacity() const {
+        return fPaths.size() + fPaints.size() + fMatrices.size();
+    }
+
+private:
+    // Slots taken outside of a scope would never be given back.
+    void checkScope() const {
+        if (fScopes.empty())
+            throw std::runtime_error(
+                "Arena objects must be made inside a 'with arena:' block.");
+    }
+
+    template <typename T>
+    struct Slot {
+        py::object object;
+        T* value;
+    };
+
+    template <typename T, typename Reset>
+    static py::object next(std::vector<Slot<T>>& slots, size_t& count,
+                           Reset reset) {
+        if (count == slots.size())
+            slots.push_back(Make<T>());
+        auto& slot = slots[count++];
+        reset(*slot.value);
+        return slot.object;
+    }
+
+    template <typename T>
+    static Slot<T> Make() {
+        auto object = py::cast(T());
+        auto value = &object.cast<T&>();
+        return { std::move(object), value };
+    }
+
+    std::vector<Slot<SkPath>> fPaths;
+    std::vector<Slot<SkPaint>> fPaints;
+    std::vector<Slot<SkMatrix>> fMatrices;
+    size_t fPathCount = 0;
+    size_t fPaintCount = 0;
+    size_t fMatrixCount = 0;
+    std::vector<std::array<size_t, 3>> fScopes;
+};
+
+}  // namespace
+
+void initArena(py::module &m) {
+py::class_<Arena>(m, "Arena", R"docstring(
+    Scoped allocation of temporary :py:class:`Path`, :py:class:`Paint` and
+    :py:class:`Matrix` objects for tight drawing loops.
+
+    Objects made by an arena are valid until the scope exits. The next scope
+    reuses them, reset to their defaults, instead of allocating new Python
+    and C++ objects. Copy an object, e.g. ``skia.Path(path)``, to keep it
+    beyond the scope. Scopes may nest; an inner scope never hands out
+    objects of the enclosing ones. Making an object outside of a scope raises
+    RuntimeError, so a loop cannot grow the arena without bound.
+
+    An arena is not thread-safe; use one per thread.
+
+    Example::
+
+        arena = skia.Arena()
+        for x, y in points:
+            with arena:
+                path = arena.Path()
+                path.addCircle(x, y, 4)
+                canvas.drawPath(path, arena.Paint(Color=skia.ColorRED))
+    )docstring")
+    .def(py::init())
+    .def("Path", &Arena::path,
+        R"docstring(
+        Returns an empty :py:class:`Path`.
+        )docstring")
+    .def("Paint", &Arena::paint,
+        R"docstring(
+        Returns a :py:class:`Paint` with default values, or with the given
+        attributes as in :py:class:`Paint` constructor.
+
+        Example::
+
+            paint = arena.Paint(Color=0xFF00FF00, AntiAlias=True)
+        )docstring")
+    .def("Matrix", &Arena::matrix,
+        R"docstring(
+        Returns an identity :py:class:`Matrix`.
+        )docstring")
+    .def("reset", &Arena::reset,
+        R"docstring(
+        Makes every object available for reuse, including those of enclosing
+        scopes.
+        )docstring")
+    .def("capacity", &Arena::capacity,
+        R"docstring(
+        Returns the number of objects kept for reuse.
+        )docstring")
+    .def("__enter__",
+        [] (Arena& arena) -> Arena& {
+            arena.enter();
+            return arena;
+        },
+        py::return_value_policy::reference)
+    .def("__exit__",
+        [] (Arena& arena, py::object exc_type, py::object exc_value,
+            py::object traceback) { arena.exit(); })
+    ;
+}
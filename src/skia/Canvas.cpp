@@ -1,4 +1,5 @@
 #include "common.h"
+#include <include/core/SkMesh.h>
 #include <include/core/SkRRect.h>
 #include <include/core/SkRSXform.h>
 #include <include/core/SkSamplingOptions.h>
@@ -2164,6 +2165,77 @@ canvas
         },
         py::arg("text"), py::arg("path"),
         py::arg("matrix"), py::arg("font"), py::arg("paint"))
+    .def("drawTextOnPaths",
+        [] (SkCanvas& self, py::iterable labels, const SkFont& font,
+            const SkPaint& paint, bool warp) {
+            SkTextOnPathBatch batch(font);
+            SkTextBlobBuilder builder;
+            for (auto item : labels) {
+                auto label = item.cast<py::tuple>();
+                if (label.size() != 2 && label.size() != 3)
+                    throw py::value_error(py::str(
+                        "Label must be (text, path) or (text, path, offset) "
+                        "(given {} elements).").format(label.size()));
+                auto text = label[0].cast<std::string>();
+                const auto& path = label[1].cast<const SkPath&>();
+                SkPoint offset = SkPoint::Make(0, 0);
+                if (label.size() == 3) {
+                    if (py::isinstance<py::float_>(label[2]) ||
+                        py::isinstance<py::int_>(label[2]))
+                        offset.fX = label[2].cast<SkScalar>();
+                    else
+                        offset = label[2].cast<SkPoint>();
+                }
+                if (warp)
+                    batch.visitPaths(
+                        text.c_str(), text.size(), path, offset.fX, offset.fY,
+                        [&self, &paint] (const SkPath& glyph) {
+                            self.drawPath(glyph, paint);
+                        });
+                else
+                    batch.appendRSXform(
+                        &builder, text.c_str(), text.size(), path, offset.fX,
+                        offset.fY);
+            }
+            if (!warp) {
+                auto blob = builder.make();
+                if (blob)
+                    self.drawTextBlob(blob, 0, 0, paint);
+            }
+        },
+        R"docstring(
+        Draws many strings along many paths with a single font and paint.
+
+        Each label is a tuple ``(text, path)`` or ``(text, path, offset)``,
+        where offset is either a distance along the path or a
+        :py:class:`Point` of (distance along the path, distance along the
+        normal). Every path is measured once per call, no matter how many
+        labels refer to it.
+
+        By default, each glyph is rotated rigidly to the path tangent at its
+        center and all labels are drawn as one :py:class:`TextBlob` of
+        :py:class:`RSXform` runs, which is much faster than bending outlines.
+        When `warp` is ``True``, glyph outlines are bent along the path as in
+        :py:meth:`drawTextOnPath`; outlines are then fetched once per glyph.
+
+        Glyphs that do not fit on the path are not drawn.
+
+        Example::
+
+            canvas.drawTextOnPaths([
+                ('Main St', path1),
+                ('Elm St', path2, 10),
+                ('Oak Ave', path3, (10, -2)),
+            ], font, paint)
+
+        :param labels: iterable of ``(text, path[, offset])`` tuples
+        :param skia.Font font: typeface, text size and so, used to describe the
+            text
+        :param skia.Paint paint: blend, color, and so on, used to draw
+        :param bool warp: bend glyph outlines instead of placing rigid glyphs
+        )docstring",
+        py::arg("labels"), py::arg("font"), py::arg("paint"),
+        py::arg("warp") = false)
     // .def("drawTextBlob",
     //     py::overload_cast<const sk_sp<SkTextBlob>&, SkScalar, SkScalar,
     //         const SkPaint&>(&SkCanvas::drawTextBlob),
@@ -2227,6 +2299,26 @@ canvas
         )docstring",
         py::arg("vertices"), py::arg("paint"),
         py::arg_v("mode", SkBlendMode::kModulate, "skia.BlendMode.kModulate"))
+    .def("drawVertices",
+        [] (SkCanvas& canvas, const std::vector<sk_sp<SkVertices>>& vertices,
+            const SkPaint& paint, SkBlendMode mode) {
+            for (auto& chunk : vertices) {
+                CHECK_NOTNULL(chunk);
+                canvas.drawVertices(chunk.get(), mode, paint);
+            }
+        },
+        R"docstring(
+        Draws a list of :py:class:`Vertices`, such as the chunks returned by
+        :py:meth:`Vertices.MakeFromArrays`, with the same paint and mode.
+
+        :param List[skia.Vertices] vertices: triangle meshes to draw
+        :param skia.BlendMode mode: combines vertices colors with
+            :py:class:`Shader`, if both are present
+        :param skia.Paint paint: specifies the :py:class:`Shader`, used as
+            :py:class:`Vertices` texture
+        )docstring",
+        py::arg("vertices"), py::arg("paint"),
+        py::arg_v("mode", SkBlendMode::kModulate, "skia.BlendMode.kModulate"))
     // .def("drawVertices",
     //     py::overload_cast<const SkVertices*, const SkPaint&>(
     //         &SkCanvas::drawVertices),
@@ -2241,6 +2333,23 @@ canvas
     //         &SkCanvas::drawVertices),
     //     "Variant of 3-parameter drawVertices, using the default of Modulate "
     //     "for the blend parameter.")
+    .def("drawMesh",
+        [] (SkCanvas& canvas, const SkMesh& mesh, const SkPaint& paint,
+            sk_sp<SkBlender> blender) {
+            canvas.drawMesh(mesh, blender, paint);
+        },
+        R"docstring(
+        Draws a :py:class:`Mesh` using clip and :py:class:`Matrix`.
+
+        The color from the mesh's fragment program is combined with the paint
+        color or shader by blender, which defaults to modulate.
+
+        :param skia.Mesh mesh: mesh to draw
+        :param skia.Paint paint: specifies the color or :py:class:`Shader`
+        :param skia.Blender blender: combines the mesh color with the paint;
+            may be None
+        )docstring",
+        py::arg("mesh"), py::arg("paint"), py::arg("blender") = nullptr)
     .def("drawPatch",
         // py::overload_cast<const SkPoint[12], const SkColor[4],
         //     const SkPoint[4], SkBlendMode, const SkPaint&>(
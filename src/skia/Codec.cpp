@@ -389,10 +389,18 @@ codec
         )docstring")
     .def("dimensions", &SkCodec::dimensions)
     .def("bounds", &SkCodec::bounds)
-    // .def("getICCProfile", &SkCodec::getICCProfile,
-    //  R"docstring(
-    //  Return the ICC profile of the encoded data.
-    //  )docstring")
+    .def("getICCProfile",
+        [] (const SkCodec& codec) -> py::object {
+            auto profile = codec.getICCProfile();
+            if (!profile || !profile->buffer)
+                return py::none();
+            return py::bytes(
+                static_cast<const char*>(profile->buffer), profile->size);
+        },
+        R"docstring(
+        Return the ICC profile of the encoded data as bytes, or None if the
+        image has no embedded profile.
+        )docstring")
     .def("getOrigin", &SkCodec::getOrigin,
         R"docstring(
         Returns the image orientation stored in the EXIF data.
@@ -1,5 +1,283 @@
 #include "common.h"
+#include <pybind11/numpy.h>
 #include <pybind11/stl.h>
+#include <algorithm>
+#include <atomic>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <unordered_map>
+
+namespace {
+
+skcms_AlphaFormat ToAlphaFormat(SkAlphaType alphaType) {
+    switch (alphaType) {
+        case kOpaque_SkAlphaType:
+            return skcms_AlphaFormat_Opaque;
+        case kPremul_SkAlphaType:
+            return skcms_AlphaFormat_PremulAsEncoded;
+        case kUnpremul_SkAlphaType:
+            return skcms_AlphaFormat_Unpremul;
+        default:
+            throw py::value_error("Unsupported alpha type.");
+    }
+}
+
+// Converts RGBA colors between two color spaces with skcms.
+class ColorSpaceXform {
+public:
+    ColorSpaceXform(sk_sp<SkColorSpace> src, sk_sp<SkColorSpace> dst)
+        : fSrc(src ? src : SkColorSpace::MakeSRGB()),
+          fDst(dst ? dst : SkColorSpace::MakeSRGB()) {
+        fSrc->toProfile(&fSrcProfile);
+        fDst->toProfile(&fDstProfile);
+        fIdentity = SkColorSpace::Equals(fSrc.get(), fDst.get());
+    }
+
+    // Transforms are shared per (src, dst) pair through an LRU cache.
+    static std::shared_ptr<ColorSpaceXform> Make(
+        sk_sp<SkColorSpace> src, sk_sp<SkColorSpace> dst) {
+        if (!src)
+            src = SkColorSpace::MakeSRGB();
+        if (!dst)
+            dst = SkColorSpace::MakeSRGB();
+        auto& cache = GetCache();
+        auto key = std::make_pair(src->hash(), dst->hash());
+        {
+            std::lock_guard<std::mutex> lock(cache.mutex);
+            auto it = cache.index.find(key);
+            if (it != cache.index.end()) {
+                const auto& xform = it->second->xform;
+                if (SkColorSpace::Equals(xform->fSrc.get(), src.get()) &&
+                    SkColorSpace::Equals(xform->fDst.get(), dst.get())) {
+                    cache.entries.splice(
+                        cache.entries.begin(), cache.entries, it->second);
+                    ++cache.hits;
+                    return xform;
+                }
+            }
+            ++cache.misses;
+        }
+
+        auto xform = std::make_shared<ColorSpaceXform>(src, dst);
+        std::lock_guard<std::mutex> lock(cache.mutex);
+        auto it = cache.index.find(key);
+        if (it != cache.index.end()) {
+            cache.entries.erase(it->second);
+            cache.index.erase(it);
+        }
+        cache.entries.push_front({ key, xform });
+        cache.index[key] = cache.entries.begin();
+        cache.trim();
+        return xform;
+    }
+
+    static py::dict CacheStats() {
+        auto& cache = GetCache();
+        std::lock_guard<std::mutex> lock(cache.mutex);
+        py::dict stats;
+        stats["hits"] = cache.hits;
+        stats["misses"] = cache.misses;
+        stats["count"] = cache.entries.size();
+        stats["limit"] = cache.limit;
+        return stats;
+    }
+
+    static void SetCacheLimit(size_t limit) {
+        auto& cache = GetCache();
+        std::lock_guard<std::mutex> lock(cache.mutex);
+        cache.limit = limit;
+        cache.trim();
+    }
+
+    static void PurgeCache(bool resetStats) {
+        auto& cache = GetCache();
+        std::lock_guard<std::mutex> lock(cache.mutex);
+        cache.entries.clear();
+        cache.index.clear();
+        if (resetStats)
+            cache.hits = cache.misses = 0;
+    }
+
+    py::array apply(py::array array, SkAlphaType alphaType, int threads) const {
+        skcms_PixelFormat format;
+        if (py::isinstance<py::array_t<float>>(array))
+            format = skcms_PixelFormat_RGBA_ffff;
+        else if (py::isinstance<py::array_t<uint8_t>>(array))
+            format = skcms_PixelFormat_RGBA_8888;
+        else
+            throw py::value_error("array must be float32 or uint8.");
+        if (array.ndim() < 1 || array.shape(array.ndim() - 1) != 4)
+            throw py::value_error("array must have 4 channels in the last axis.");
+        if (!(array.flags() & py::array::c_style))
+            throw py::value_error("array must be C-contiguous.");
+        auto alphaFormat = ToAlphaFormat(alphaType);
+        size_t count = array.size() / 4;
+        if (fIdentity || count == 0)
+            return array;
+
+        char* pixels = static_cast<char*>(array.mutable_data());
+        size_t pixelSize = array.itemsize() * 4;
+        const size_t kChunk = 1 << 16;
+        int chunks = static_cast<int>((count + kChunk - 1) / kChunk);
+        std::atomic<bool> ok(true);
+        {
+            py::gil_scoped_release release;
+            ParallelFor(chunks, threads, [&] (int i) {
+                size_t begin = i * kChunk;
+                size_t n = std::min(kChunk, count - begin);
+                void* ptr = pixels + begin * pixelSize;
+                if (!skcms_Transform(ptr, format, alphaFormat, &fSrcProfile,
+                                     ptr, format, alphaFormat, &fDstProfile, n))
+                    ok = false;
+            });
+        }
+        if (!ok)
+            throw std::runtime_error("Failed to transform colors.");
+        return array;
+    }
+
+    sk_sp<SkColorSpace> src() const { return fSrc; }
+    sk_sp<SkColorSpace> dst() const { return fDst; }
+
+private:
+    using Key = std::pair<uint32_t, uint32_t>;
+
+    struct Entry {
+        Key key;
+        std::shared_ptr<ColorSpaceXform> xform;
+    };
+
+    struct Cache {
+        void trim() {
+            while (entries.size() > limit) {
+                index.erase(entries.back().key);
+                entries.pop_back();
+            }
+        }
+
+        std::mutex mutex;
+        std::list<Entry> entries;  // Most recently used first.
+        std::map<Key, std::list<Entry>::iterator> index;
+        size_t limit = 64;
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+    };
+
+    static Cache& GetCache() {
+        static Cache cache;
+        return cache;
+    }
+
+    sk_sp<SkColorSpace> fSrc;
+    sk_sp<SkColorSpace> fDst;
+    skcms_ICCProfile fSrcProfile;
+    skcms_ICCProfile fDstProfile;
+    bool fIdentity;
+};
+
+// LRU cache of color spaces keyed by a hash of the raw ICC profile bytes.
+class ICCColorSpaceCache {
+public:
+    static ICCColorSpaceCache& Get() {
+        static ICCColorSpaceCache cache;
+        return cache;
+    }
+
+    sk_sp<SkColorSpace> find(const void* data, size_t size) {
+        if (!data || !size)
+            return nullptr;
+        auto bytes = std::string_view(static_cast<const char*>(data), size);
+        auto key = std::hash<std::string_view>()(bytes);
+        {
+            std::lock_guard<std::mutex> lock(fMutex);
+            auto it = fIndex.find(key);
+            if (it != fIndex.end() && it->second->profile->equals(
+                    SkData::MakeWithoutCopy(data, size).get())) {
+                fEntries.splice(fEntries.begin(), fEntries, it->second);
+                ++fHits;
+                return it->second->colorSpace;
+            }
+            ++fMisses;
+        }
+
+        // Parse outside of the lock; racing threads may parse the same profile.
+        sk_sp<SkColorSpace> colorSpace;
+        skcms_ICCProfile profile;
+        if (skcms_Parse(data, size, &profile))
+            colorSpace = SkColorSpace::Make(profile);
+
+        std::lock_guard<std::mutex> lock(fMutex);
+        auto it = fIndex.find(key);
+        if (it != fIndex.end()) {
+            fBytes -= it->second->profile->size();
+            fEntries.erase(it->second);
+            fIndex.erase(it);
+        }
+        fEntries.push_front({ key, SkData::MakeWithCopy(data, size), colorSpace });
+        fIndex[key] = fEntries.begin();
+        fBytes += size;
+        trim();
+        return colorSpace;
+    }
+
+    py::dict stats() {
+        std::lock_guard<std::mutex> lock(fMutex);
+        py::dict stats;
+        stats["hits"] = fHits;
+        stats["misses"] = fMisses;
+        stats["count"] = fEntries.size();
+        stats["bytes"] = fBytes;
+        stats["limit"] = fLimit;
+        return stats;
+    }
+
+    void setLimit(size_t limit) {
+        std::lock_guard<std::mutex> lock(fMutex);
+        fLimit = limit;
+        trim();
+    }
+
+    void purge(bool resetStats) {
+        std::lock_guard<std::mutex> lock(fMutex);
+        fEntries.clear();
+        fIndex.clear();
+        fBytes = 0;
+        if (resetStats)
+            fHits = fMisses = 0;
+    }
+
+private:
+    struct Entry {
+        size_t key;
+        sk_sp<SkData> profile;
+        sk_sp<SkColorSpace> colorSpace;
+    };
+
+    void trim() {
+        while (fEntries.size() > fLimit) {
+            fBytes -= fEntries.back().profile->size();
+            fIndex.erase(fEntries.back().key);
+            fEntries.pop_back();
+        }
+    }
+
+    std::mutex fMutex;
+    std::list<Entry> fEntries;
+    std::unordered_map<size_t, std::list<Entry>::iterator> fIndex;
+    size_t fLimit = 64;
+    size_t fBytes = 0;
+    size_t fHits = 0;
+    size_t fMisses = 0;
+};
+
+}  // namespace
+
+sk_sp<SkColorSpace> ColorSpaceFromICC(const void* data, size_t size) {
+    return ICCColorSpaceCache::Get().find(data, size);
+}
 
 void initColorSpace(py::module &m) {
 // TODO: Implement skcms APIs.
@@ -220,5 +498,103 @@ py::class_<SkColorSpace, sk_sp<SkColorSpace>>(m, "ColorSpace")
         )docstring",
         py::arg("self"), py::arg("other"))
     .def("__eq__", &SkColorSpace::Equals, py::is_operator())
+    .def_static("MakeFromICC",
+        [] (py::buffer b) {
+            auto info = b.request();
+            size_t size = (info.ndim) ? info.strides[0] * info.shape[0] : 0;
+            return ColorSpaceFromICC(info.ptr, size);
+        },
+        R"docstring(
+        Create an :py:class:`ColorSpace` from raw ICC profile bytes.
+
+        Results are cached by profile contents, so repeated profiles are
+        parsed once and share one :py:class:`ColorSpace`.
+
+        :param data: ICC profile bytes
+        :return: :py:class:`ColorSpace`, or None if the profile is invalid or
+            cannot be represented
+        )docstring",
+        py::arg("data"))
+    .def_static("GetICCCacheStats",
+        [] { return ICCColorSpaceCache::Get().stats(); },
+        R"docstring(
+        Returns a dict of ICC profile cache statistics: ``hits``, ``misses``,
+        ``count``, ``bytes`` of cached profiles, and the entry ``limit``.
+        )docstring")
+    .def_static("SetICCCacheLimit",
+        [] (size_t limit) { ICCColorSpaceCache::Get().setLimit(limit); },
+        R"docstring(
+        Sets the maximum number of cached ICC profiles, evicting the least
+        recently used ones. 0 disables caching.
+        )docstring",
+        py::arg("limit"))
+    .def_static("PurgeICCCache",
+        [] (bool resetStats) { ICCColorSpaceCache::Get().purge(resetStats); },
+        R"docstring(
+        Drops all cached ICC profiles.
+
+        :param bool resetStats: also reset hit and miss counts
+        )docstring",
+        py::arg("resetStats") = false)
+    ;
+
+py::class_<ColorSpaceXform, std::shared_ptr<ColorSpaceXform>>(
+    m, "ColorSpaceXform",
+    R"docstring(
+    Converts arrays of RGBA colors from one :py:class:`ColorSpace` to another
+    without drawing.
+
+    Transforms are cached per source and destination pair, so constructing
+    the same transform again is cheap. The cache keeps the most recently used
+    transforms; see :py:meth:`SetCacheLimit`. ``None`` stands for sRGB.
+
+    Example::
+
+        xform = skia.ColorSpaceXform(
+            skia.ColorSpace.MakeSRGB(), skia.ColorSpace.MakeSRGBLinear())
+        colors = np.random.rand(1000, 4).astype(np.float32)
+        xform.apply(colors)
+    )docstring")
+    .def(py::init(
+        [] (const SkColorSpace* src, const SkColorSpace* dst) {
+            return ColorSpaceXform::Make(
+                CloneColorSpace(src), CloneColorSpace(dst));
+        }),
+        py::arg("src"), py::arg("dst"))
+    .def("apply", &ColorSpaceXform::apply,
+        R"docstring(
+        Converts colors in place and returns the array.
+
+        :param numpy.ndarray array: C-contiguous float32 or uint8 array whose
+            last axis holds RGBA, such as (N, 4) colors or (height, width, 4)
+            pixels
+        :param skia.AlphaType alphaType: whether colors are premultiplied
+        :param int threads: number of threads; 0 uses all cores
+        :return: array
+        )docstring",
+        py::arg("array"),
+        py::arg_v("alphaType", kUnpremul_SkAlphaType,
+            "skia.AlphaType.kUnpremul_AlphaType"),
+        py::arg("threads") = 1)
+    .def("src", &ColorSpaceXform::src)
+    .def("dst", &ColorSpaceXform::dst)
+    .def_static("GetCacheStats", &ColorSpaceXform::CacheStats,
+        R"docstring(
+        Returns a dict of transform cache statistics: ``hits``, ``misses``,
+        ``count``, and the entry ``limit``.
+        )docstring")
+    .def_static("SetCacheLimit", &ColorSpaceXform::SetCacheLimit,
+        R"docstring(
+        Sets the maximum number of cached transforms, evicting the least
+        recently used ones. 0 disables caching.
+        )docstring",
+        py::arg("limit"))
+    .def_static("PurgeCache", &ColorSpaceXform::PurgeCache,
+        R"docstring(
+        Drops all cached transforms.
+
+        :param bool resetStats: also reset hit and miss counts
+        )docstring",
+        py::arg("resetStats") = false)
     ;
 }
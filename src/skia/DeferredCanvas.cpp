@@ -0,0 +1,272 @@
+#include "common.h"
+#include <include/core/SkPictureRecorder.h>
+#include <include/core/SkSurface.h>
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace {
+
+// Records each frame into a picture on the calling thread, and plays it back
+// into a raster surface on a worker thread. The worker holds the GIL only to
+// complete futures, and shares State so that it may outlive the canvas, e.g.
+// when a future callback drops the last reference.
+class DeferredCanvas {
+public:
+    DeferredCanvas(const SkImageInfo& info, size_t maxPending)
+        : fState(std::make_shared<State>(info, maxPending)) {
+        fWorker = std::thread(&State::run, fState);
+    }
+
+    ~DeferredCanvas() { close(); }
+
+    SkCanvas* beginFrame() {
+        if (isClosed())
+            throw std::runtime_error("DeferredCanvas is closed.");
+        if (fRecorder.getRecordingCanvas())
+            throw std::runtime_error("A frame is already being recorded.");
+        return fRecorder.beginRecording(
+            SkRect::Make(fState->fInfo.dimensions()));
+    }
+
+    py::object endFrame() {
+        if (!fRecorder.getRecordingCanvas())
+            throw std::runtime_error("No frame is being recorded.");
+        Frame frame;
+        // Play nested pictures inline while holding the GIL, so the worker
+        // never calls into Python subclasses of Picture.
+        frame.picture = PictureFlatten(*fRecorder.finishRecordingAsPicture());
+        frame.future = py::module::import("concurrent.futures").attr("Future")();
+        frame.future.attr("set_running_or_notify_cancel")();
+        py::object future = frame.future;
+        auto& state = *fState;
+        bool closed = false;
+        {
+            py::gil_scoped_release release;
+            std::unique_lock<std::mutex> lock(state.fMutex);
+            state.fNotFull.wait(lock, [&state] {
+                return state.fClosed || state.fQueue.size() < state.fMaxPending;
+            });
+            closed = state.fClosed;
+            if (!closed) {
+                state.fQueue.push_back(std::move(frame));
+                ++state.fPending;
+            }
+        }
+        if (closed)
+            throw std::runtime_error("DeferredCanvas is closed.");
+        state.fNotEmpty.notify_one();
+        return future;
+    }
+
+    size_t pending() {
+        std::lock_guard<std::mutex> lock(fState->fMutex);
+        return fState->fPending;
+    }
+
+    void wait() {
+        auto& state = *fState;
+        py::gil_scoped_release release;
+        std::unique_lock<std::mutex> lock(state.fMutex);
+        state.fIdle.wait(lock, [&state] { return state.fPending == 0; });
+    }
+
+    void close() {
+        {
+            std::lock_guard<std::mutex> lock(fState->fMutex);
+            fState->fClosed = true;
+        }
+        fState->fNotEmpty.notify_all();
+        fState->fNotFull.notify_all();
+        if (!fWorker.joinable())
+            return;
+        // A future callback runs on the worker, which cannot join itself; it
+        // drains the queue and exits on its own.
+        if (std::this_thread::get_id() == fWorker.get_id()) {
+            fWorker.detach();
+            return;
+        }
+        py::gil_scoped_release release;
+        fWorker.join();
+    }
+
+    bool isClosed() {
+        std::lock_guard<std::mutex> lock(fState->fMutex);
+        return fState->fClosed;
+    }
+
+    const SkImageInfo& imageInfo() const { return fState->fInfo; }
+
+private:
+    struct Frame {
+        sk_sp<SkPicture> picture;
+        py::object future;
+    };
+
+    struct State {
+        State(const SkImageInfo& info, size_t maxPending)
+            : fInfo(info), fMaxPending(std::max<size_t>(maxPending, 1)) {
+            fSurface = SkSurfaces::Raster(info);
+            if (!fSurface)
+                throw std::runtime_error("Failed to create a raster surface.");
+        }
+
+        // Drains the queue before exiting, so close() completes every future.
+        void run() {
+            for (;;) {
+                Frame frame;
+                {
+                    std::unique_lock<std::mutex> lock(fMutex);
+                    fNotEmpty.wait(lock, [this] {
+                        return fClosed || !fQueue.empty();
+                    });
+                    if (fQueue.empty())
+                        return;
+                    frame = std::move(fQueue.front());
+                    fQueue.pop_front();
+                }
+                fNotFull.notify_one();
+
+                auto canvas = fSurface->getCanvas();
+                canvas->clear(SK_ColorTRANSPARENT);
+                canvas->drawPicture(frame.picture);
+                auto image = fSurface->makeImageSnapshot();
+                frame.picture.reset();
+                {
+                    py::gil_scoped_acquire acquire;
+                    try {
+                        if (image)
+                            frame.future.attr("set_result")(image);
+                        else
+                            frame.future.attr("set_exception")(
+                                py::module::import("builtins").attr(
+                                    "RuntimeError")("Failed to rasterize."));
+                    }
+                    catch (py::error_already_set& e) {
+                        e.discard_as_unraisable(__func__);
+                    }
+                    frame.future = py::object();
+                    image.reset();
+                }
+                {
+                    std::lock_guard<std::mutex> lock(fMutex);
+                    --fPending;
+                }
+                fIdle.notify_all();
+            }
+        }
+
+        SkImageInfo fInfo;
+        size_t fMaxPending;
+        sk_sp<SkSurface> fSurface;
+        std::mutex fMutex;
+        std::condition_variable fNotEmpty;
+        std::condition_variable fNotFull;
+        std::condition_variable fIdle;
+        std::deque<Frame> fQueue;
+        size_t fPending = 0;
+        bool fClosed = false;
+    };
+
+    std::shared_ptr<State> fState;
+    SkPictureRecorder fRecorder;
+    std::thread fWorker;
+};
+
+}  // namespace
+
+void initDeferredCanvas(py::module &m) {
+py::class_<DeferredCanvas>(m, "DeferredCanvas", R"docstring(
+    Records drawing on the calling thread and rasterizes it on a background
+    thread.
+
+    :py:meth:`beginFrame` returns a recording :py:class:`Canvas`, so drawing
+    calls return immediately. :py:meth:`endFrame` finishes the recording as a
+    :py:class:`Picture`, queues it for a native raster thread, and returns a
+    :py:class:`concurrent.futures.Future` whose result is the frame as an
+    :py:class:`Image`. When ``maxPending`` frames are already waiting,
+    :py:meth:`endFrame` blocks until the raster thread catches up.
+
+    Futures are completed on the raster thread, so callbacks added with
+    ``add_done_callback`` run there.
+
+    Example::
+
+        with skia.DeferredCanvas(640, 480) as deferred:
+            canvas = deferred.beginFrame()
+            canvas.drawCircle(320, 240, 100, skia.Paint(Color=skia.ColorRED))
+            future = deferred.endFrame()
+            array = future.result().toarray()
+    )docstring")
+    .def(py::init<const SkImageInfo&, size_t>(),
+        R"docstring(
+        Creates a deferred canvas that rasterizes frames described by ``info``.
+
+        :param skia.ImageInfo info: width, height, color type and alpha type of
+            frames
+        :param int maxPending: number of finished frames that may wait for the
+            raster thread before :py:meth:`endFrame` blocks
+        )docstring",
+        py::arg("info"), py::arg("maxPending") = 2)
+    .def(py::init(
+        [] (int width, int height, size_t maxPending) {
+            return new DeferredCanvas(
+                SkImageInfo::MakeN32Premul(width, height), maxPending);
+        }),
+        R"docstring(
+        Creates a deferred canvas that rasterizes N32 premultiplied frames.
+
+        :param int width: frame width
+        :param int height: frame height
+        :param int maxPending: number of finished frames that may wait for the
+            raster thread before :py:meth:`endFrame` blocks
+        )docstring",
+        py::arg("width"), py::arg("height"), py::arg("maxPending") = 2)
+    .def("beginFrame", &DeferredCanvas::beginFrame,
+        R"docstring(
+        Starts recording a frame and returns the recording canvas.
+
+        The canvas is valid until :py:meth:`endFrame`.
+
+        :rtype: skia.Canvas
+        )docstring",
+        py::return_value_policy::reference_internal)
+    .def("endFrame", &DeferredCanvas::endFrame,
+        R"docstring(
+        Finishes the frame and queues it for rasterization.
+
+        Blocks, without the GIL, while ``maxPending`` frames are waiting.
+
+        :return: future of the rasterized :py:class:`Image`
+        :rtype: concurrent.futures.Future
+        )docstring")
+    .def("pending", &DeferredCanvas::pending,
+        R"docstring(
+        Returns the number of frames queued or being rasterized.
+        )docstring")
+    .def("wait", &DeferredCanvas::wait,
+        R"docstring(
+        Blocks until every queued frame is rasterized.
+        )docstring")
+    .def("close", &DeferredCanvas::close,
+        R"docstring(
+        Rasterizes queued frames and stops the raster thread.
+
+        Later calls to :py:meth:`beginFrame` raise an error.
+        )docstring")
+    .def("isClosed", &DeferredCanvas::isClosed)
+    .def("imageInfo", &DeferredCanvas::imageInfo,
+        R"docstring(
+        Returns :py:class:`ImageInfo` of rasterized frames.
+        )docstring")
+    .def("__enter__",
+        [] (DeferredCanvas& self) -> DeferredCanvas& { return self; },
+        py::return_value_policy::reference)
+    .def("__exit__",
+        [] (DeferredCanvas& self, py::object exc_type, py::object exc_value,
+            py::object traceback) { self.close(); })
+    ;
+}
@@ -23,11 +23,99 @@
 #include <pybind11/chrono.h>
 #include <pybind11/stl.h>
 #include <pybind11/cast.h>
+#include <atomic>
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <string_view>
+
+#ifdef _WIN32
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
 
 void initGrContext_gl(py::module&);
 void initGrContext_mock(py::module&);
 void initGrContext_vk(py::module&);
 
+namespace {
+
+int CurrentProcessId() {
+#ifdef _WIN32
+    return _getpid();
+#else
+    return static_cast<int>(getpid());
+#endif
+}
+
+/*
+  GrContextOptions::PersistentCache that keeps each compiled program in its own
+  file under a directory, so that shader and pipeline compilation results
+  survive across processes. Files are written to a temporary name and renamed,
+  which lets several workers share one directory.
+*/
+class GrDiskPersistentCache : public GrContextOptions::PersistentCache {
+public:
+    explicit GrDiskPersistentCache(std::string directory)
+        : fDirectory(std::move(directory)) {}
+
+    sk_sp<SkData> load(const SkData& key) override {
+        auto file = SkData::MakeFromFileName(this->path(key).c_str());
+        // Each file starts with its key so that hash collisions are misses.
+        if (!file || file->size() < key.size() ||
+            !key.equals(SkData::MakeWithoutCopy(file->data(), key.size()).get())) {
+            ++fMisses;
+            return nullptr;
+        }
+        ++fHits;
+        return SkData::MakeSubset(
+            file.get(), key.size(), file->size() - key.size());
+    }
+
+    void store(const SkData& key, const SkData& data,
+               const SkString& /*description*/) override {
+        // The pid and a per-process counter make the temporary name unique
+        // across every thread of every process sharing the directory.
+        static std::atomic<uint64_t> counter{0};
+        auto path = this->path(key);
+        auto temp = path + ".tmp" + std::to_string(CurrentProcessId()) + "." +
+            std::to_string(counter++);
+        {
+            SkFILEWStream stream(temp.c_str());
+            if (!stream.isValid() || !stream.write(key.data(), key.size()) ||
+                !stream.write(data.data(), data.size()))
+                return;
+        }
+        if (std::rename(temp.c_str(), path.c_str()) == 0)
+            ++fStores;
+        else
+            std::remove(temp.c_str());
+    }
+
+    const std::string& directory() const { return fDirectory; }
+    uint64_t hits() const { return fHits; }
+    uint64_t misses() const { return fMisses; }
+    uint64_t stores() const { return fStores; }
+
+private:
+    std::string path(const SkData& key) const {
+        auto hash = std::hash<std::string_view>()(std::string_view(
+            static_cast<const char*>(key.data()), key.size()));
+        char name[32];
+        std::snprintf(name, sizeof(name), "%016llx.bin",
+                      static_cast<unsigned long long>(hash));
+        return fDirectory + "/" + name;
+    }
+
+    std::string fDirectory;
+    std::atomic<uint64_t> fHits{0};
+    std::atomic<uint64_t> fMisses{0};
+    std::atomic<uint64_t> fStores{0};
+};
+
+}  // namespace
+
 void initGrContext(py::module &m) {
 
 py::enum_<GrBackendApi>(m, "GrBackendApi",
@@ -396,9 +484,86 @@ py::class_<GrBackendTexture>(m, "GrBackendTexture")
         py::arg("texture"))
     ;
 
-py::class_<GrContextOptions>(m, "GrContextOptions")
+py::class_<GrContextOptions> contextoptions(m, "GrContextOptions");
+
+py::enum_<GrContextOptions::ShaderCacheStrategy>(
+    contextoptions, "ShaderCacheStrategy")
+    .value("kSkSL", GrContextOptions::ShaderCacheStrategy::kSkSL)
+    .value("kBackendSource",
+        GrContextOptions::ShaderCacheStrategy::kBackendSource)
+    .value("kBackendBinary",
+        GrContextOptions::ShaderCacheStrategy::kBackendBinary)
+    .export_values();
+
+py::class_<GrContextOptions::PersistentCache>(
+    contextoptions, "PersistentCache", R"docstring(
+    Abstract class which stores Skia data in a cache that persists between
+    sessions.
+    )docstring")
+    .def("load", &GrContextOptions::PersistentCache::load,
+        R"docstring(
+        Returns the data stored for ``key``, or None.
+        )docstring",
+        py::arg("key"))
+    .def("store",
+        [] (GrContextOptions::PersistentCache& cache, const SkData& key,
+            const SkData& data, const std::string& description) {
+            cache.store(key, data, SkString(description));
+        },
+        R"docstring(
+        Stores ``data`` for ``key``.
+        )docstring",
+        py::arg("key"), py::arg("data"), py::arg("description") = "");
+
+py::class_<GrDiskPersistentCache, GrContextOptions::PersistentCache>(
+    m, "GrDiskPersistentCache", R"docstring(
+    :py:class:`GrContextOptions.PersistentCache` that stores compiled GPU
+    programs as files in a directory.
+
+    Set it as :py:attr:`GrContextOptions.fPersistentCache` before creating a
+    context. The cache must be kept alive while any context created with the
+    options is alive. The directory must exist; several processes may share
+    it.
+
+    Example::
+
+        cache = skia.GrDiskPersistentCache('/var/cache/skia')
+        options = skia.GrContextOptions()
+        options.fPersistentCache = cache
+        context = skia.GrDirectContext.MakeGL(options)
+    )docstring")
+    .def(py::init<std::string>(), py::arg("directory"))
+    .def("directory", &GrDiskPersistentCache::directory)
+    .def("hits", &GrDiskPersistentCache::hits,
+        "Number of successful loads.")
+    .def("misses", &GrDiskPersistentCache::misses,
+        "Number of loads that found no program.")
+    .def("stores", &GrDiskPersistentCache::stores,
+        "Number of programs written.")
+    ;
+
+contextoptions
     .def(py::init<>())
-    // TODO: Implement me!
+    .def_property("fPersistentCache",
+        [] (const GrContextOptions& options) {
+            return options.fPersistentCache;
+        },
+        py::cpp_function(
+            [] (GrContextOptions& options,
+                GrContextOptions::PersistentCache* cache) {
+                options.fPersistentCache = cache;
+            },
+            py::keep_alive<1, 2>()),
+        py::return_value_policy::reference,
+        R"docstring(
+        Cache in which to store compiled shader binaries between runs; may be
+        None.
+        )docstring")
+    .def_readwrite("fShaderCacheStrategy",
+        &GrContextOptions::fShaderCacheStrategy,
+        R"docstring(
+        What data is stored in fPersistentCache.
+        )docstring")
     ;
 
 /* m118: Remove GrBackendSurfaceMutableState */
@@ -736,6 +901,19 @@ py::class_<GrDirectContext, sk_sp<GrDirectContext>, GrRecordingContext>(m, "GrDi
         R"docstring(
         Return the current GPU resource cache limit in bytes.
         )docstring")
+    .def("getResourceCacheUsage",
+        [] (const GrDirectContext& context) {
+            int resourceCount = 0;
+            size_t resourceBytes = 0;
+            context.getResourceCacheUsage(&resourceCount, &resourceBytes);
+            return py::make_tuple(resourceCount, resourceBytes);
+        },
+        R"docstring(
+        Gets the current GPU resource cache usage.
+
+        :return: tuple of the number of resources held in the cache and the
+            total number of bytes of video memory they hold
+        )docstring")
     .def("getResourceCacheUsage", &GrDirectContext::getResourceCacheUsage,
         R"docstring(
         Gets the current GPU resource cache usage.
@@ -924,9 +1102,24 @@ py::class_<GrDirectContext, sk_sp<GrDirectContext>, GrRecordingContext>(m, "GrDi
         )docstring")
     // .def("priv", (GrContextPriv (GrDirectContext::*)()) &GrContext::priv)
     // .def("priv", (const GrContextPriv (GrDirectContext::*)() const) &GrContext::priv)
-    // .def("dumpMemoryStatistics", &GrDirectContext::dumpMemoryStatistics,
-    //     "Enumerates all cached GPU resources and dumps their memory to "
-    //     "traceMemoryDump.")
+    .def("dumpMemoryStatistics",
+        [] (const GrDirectContext& context, bool detailed, bool asArrays) {
+            return CollectMemoryDump(
+                [&] (SkTraceMemoryDump* dump) {
+                    context.dumpMemoryStatistics(dump);
+                },
+                detailed, asArrays);
+        },
+        R"docstring(
+        Enumerates all cached GPU resources and returns their memory.
+
+        See :py:meth:`Graphics.CollectMemoryStatistics` for the result format.
+
+        :param bool detailed: break resources down individually
+        :param bool asArrays: return columns instead of a dict of dicts
+        :return: dict
+        )docstring",
+        py::arg("detailed") = false, py::arg("asArrays") = false)
     .def("supportsDistanceFieldText", &GrDirectContext::supportsDistanceFieldText)
     .def("storeVkPipelineCacheData", py::overload_cast<>(&GrDirectContext::storeVkPipelineCacheData))
     .def_static("ComputeImageSize",
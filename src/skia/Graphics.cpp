@@ -0,0 +1,301 @@
+#include "common.h"
+#include <include/core/SkGraphics.h>
+#include <include/core/SkTraceMemoryDump.h>
+#include <pybind11/numpy.h>
+#include <pybind11/stl.h>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace {
+
+// Collects everything dumped to it; SkGraphics may call it without the GIL,
+// so values are kept in C++ until the dump finishes.
+class MemoryDumpCollector : public SkTraceMemoryDump {
+public:
+    explicit MemoryDumpCollector(bool detailed) : fDetailed(detailed) {}
+
+    void dumpNumericValue(const char* dumpName, const char* valueName,
+                          const char* units, uint64_t value) override {
+        fNumbers.push_back({ dumpName, valueName, units, value });
+    }
+
+    void dumpStringValue(const char* dumpName, const char* valueName,
+                         const char* value) override {
+        fStrings.push_back({ dumpName, valueName, value });
+    }
+
+    void setMemoryBacking(const char* dumpName, const char* backingType,
+                          const char* backingObjectId) override {
+        fStrings.push_back({ dumpName, "backing_type", backingType });
+        fStrings.push_back({ dumpName, "backing_object_id", backingObjectId });
+    }
+
+    void setDiscardableMemoryBacking(
+        const char* dumpName, const SkDiscardableMemory&) override {
+        fStrings.push_back({ dumpName, "backing_type", "discardable" });
+    }
+
+    LevelOfDetail getRequestedDetails() const override {
+        return fDetailed ? SkTraceMemoryDump::kObjectsBreakdowns_LevelOfDetail :
+                           SkTraceMemoryDump::kLight_LevelOfDetail;
+    }
+
+    py::dict toDict() const {
+        std::map<std::string, py::dict> dumps;
+        for (auto& number : fNumbers)
+            dumps[number.dumpName][number.valueName.c_str()] = number.value;
+        for (auto& string : fStrings)
+            dumps[string.dumpName][string.valueName.c_str()] = string.value;
+        py::dict result;
+        for (auto& it : dumps)
+            result[it.first.c_str()] = it.second;
+        return result;
+    }
+
+    // Numeric values as columns that pandas.DataFrame accepts as is.
+    py::dict toColumns() const {
+        py::list dumpNames, valueNames, units;
+        py::array_t<uint64_t> values(fNumbers.size());
+        auto data = values.mutable_data();
+        for (size_t i = 0; i < fNumbers.size(); ++i) {
+            dumpNames.append(fNumbers[i].dumpName);
+            valueNames.append(fNumbers[i].valueName);
+            units.append(fNumbers[i].units);
+            data[i] = fNumbers[i].value;
+        }
+        py::dict result;
+        result["dumpName"] = dumpNames;
+        result["valueName"] = valueNames;
+        result["units"] = units;
+        result["value"] = values;
+        return result;
+    }
+
+private:
+    struct NumericValue {
+        std::string dumpName;
+        std::string valueName;
+        std::string units;
+        uint64_t value;
+    };
+
+    struct StringValue {
+        std::string dumpName;
+        std::string valueName;
+        std::string value;
+    };
+
+    bool fDetailed;
+    std::vector<NumericValue> fNumbers;
+    std::vector<StringValue> fStrings;
+};
+
+}  // namespace
+
+py::dict CollectMemoryDump(
+    const std::function<void(SkTraceMemoryDump*)>& dump, bool detailed,
+    bool asArrays, bool releaseGIL) {
+    MemoryDumpCollector collector(detailed);
+    if (releaseGIL) {
+        py::gil_scoped_release release;
+        dump(&collector);
+    } else
+        dump(&collector);
+    return (asArrays) ? collector.toColumns() : collector.toDict();
+}
+
+void initGraphics(py::module &m) {
+py::class_<SkGraphics>(m, "Graphics",
+    R"docstring(
+    Process-wide caches of Skia: the font cache, which holds glyph images and
+    paths, and the resource cache, which holds decoded images and other
+    discardable CPU allocations.
+
+    Example::
+
+        skia.Graphics.SetFontCacheLimit(16 * 1024 * 1024)
+        print(skia.Graphics.GetResourceCacheTotalBytesUsed())
+        skia.Graphics.PurgeAllCaches()
+    )docstring")
+    .def_static("Init", &SkGraphics::Init,
+        R"docstring(
+        Call this at process initialization time if your environment does not
+        permit static global initializers that execute code.
+        )docstring")
+    .def_static("GetFontCacheLimit", &SkGraphics::GetFontCacheLimit,
+        R"docstring(
+        Return the max number of bytes that should be used by the font cache.
+
+        If the cache needs to allocate more, it will purge previous entries.
+        This max can be changed by calling :py:meth:`SetFontCacheLimit`.
+        )docstring")
+    .def_static("SetFontCacheLimit", &SkGraphics::SetFontCacheLimit,
+        R"docstring(
+        Specify the max number of bytes that should be used by the font cache.
+
+        If the cache needs to allocate more, it will purge previous entries.
+
+        :param int bytes: new limit
+        :return: the previous limit
+        )docstring",
+        py::arg("bytes"))
+    .def_static("GetFontCacheUsed", &SkGraphics::GetFontCacheUsed,
+        R"docstring(
+        Return the number of bytes currently used by the font cache.
+        )docstring")
+    .def_static("GetFontCacheCountUsed", &SkGraphics::GetFontCacheCountUsed,
+        R"docstring(
+        Return the number of entries in the font cache.
+
+        A cache "entry" is associated with each typeface + pointSize + matrix.
+        )docstring")
+    .def_static("GetFontCacheCountLimit", &SkGraphics::GetFontCacheCountLimit,
+        R"docstring(
+        Return the current limit to the number of entries in the font cache.
+        )docstring")
+    .def_static("SetFontCacheCountLimit", &SkGraphics::SetFontCacheCountLimit,
+        R"docstring(
+        Set the limit to the number of entries in the font cache, and return
+        the previous value. If this new value is lower than the previous,
+        it will automatically try to purge entries to meet the new limit.
+        )docstring",
+        py::arg("count"))
+    .def_static("PurgeFontCache", &SkGraphics::PurgeFontCache,
+        R"docstring(
+        For debugging purposes, this will attempt to purge the font cache. It
+        does not change the limit, but will cause subsequent font measures and
+        draws to be recreated, since they will no longer be in the cache.
+        )docstring")
+    .def_static("GetResourceCacheTotalBytesUsed",
+        &SkGraphics::GetResourceCacheTotalBytesUsed,
+        R"docstring(
+        Returns the number of bytes used by the resource cache, which holds
+        decoded images and other discardable CPU allocations.
+        )docstring")
+    .def_static("GetResourceCacheTotalByteLimit",
+        &SkGraphics::GetResourceCacheTotalByteLimit,
+        R"docstring(
+        Returns the max number of bytes that should be used by the resource
+        cache.
+        )docstring")
+    .def_static("SetResourceCacheTotalByteLimit",
+        &SkGraphics::SetResourceCacheTotalByteLimit,
+        R"docstring(
+        Sets the max number of bytes that should be used by the resource
+        cache, and returns the previous limit.
+        )docstring",
+        py::arg("newLimit"))
+    .def_static("GetResourceCacheSingleAllocationByteLimit",
+        &SkGraphics::GetResourceCacheSingleAllocationByteLimit,
+        R"docstring(
+        Returns the largest single allocation the resource cache accepts, or
+        0 if there is no limit.
+        )docstring")
+    .def_static("SetResourceCacheSingleAllocationByteLimit",
+        &SkGraphics::SetResourceCacheSingleAllocationByteLimit,
+        R"docstring(
+        Sets the largest single allocation the resource cache accepts, and
+        returns the previous limit. 0 means no limit.
+        )docstring",
+        py::arg("newLimit"))
+    .def_static("PurgeResourceCache", &SkGraphics::PurgeResourceCache,
+        R"docstring(
+        For debugging purposes, this will attempt to purge the resource cache.
+        It does not change the limit.
+        )docstring")
+    .def_static("PurgeAllCaches", &SkGraphics::PurgeAllCaches,
+        R"docstring(
+        Free as much globally cached memory as possible. This will purge all
+        private caches in Skia, including font and image caches.
+
+        If there are caches associated with GPU context, those will not be
+        affected by this call.
+        )docstring")
+    .def_static("DumpMemoryStatistics",
+        [] (bool detailed) {
+            return CollectMemoryDump(
+                &SkGraphics::DumpMemoryStatistics, detailed, false, true);
+        },
+        R"docstring(
+        Returns memory used by the font cache and the resource cache.
+
+        The result maps each dump name, such as
+        ``skia/sk_glyph_cache`` or ``skia/sk_resource_cache/...``, to a dict of
+        its values, e.g. ``{'size': 1024, 'backing_type': 'malloc'}``. Sizes
+        are in bytes.
+
+        :param bool detailed: break caches down into individual entries
+        :return: dict of dicts
+        )docstring",
+        py::arg("detailed") = false)
+    .def_static("CollectMemoryStatistics",
+        [] (GrDirectContext* context,
+            const std::vector<sk_sp<SkPicture>>& pictures,
+            const std::vector<SkPath>& paths, bool detailed, bool asArrays) {
+            // Pictures may be Python subclasses, so size them with the GIL.
+            std::vector<std::pair<size_t, int>> pictureSizes;
+            for (auto& picture : pictures) {
+                CHECK_NOTNULL(picture);
+                pictureSizes.emplace_back(
+                    picture->approximateBytesUsed(),
+                    picture->approximateOpCount(true));
+            }
+            return CollectMemoryDump(
+                [&] (SkTraceMemoryDump* dump) {
+                    SkGraphics::DumpMemoryStatistics(dump);
+                    if (context)
+                        context->dumpMemoryStatistics(dump);
+                    for (size_t i = 0; i < pictureSizes.size(); ++i) {
+                        auto name = "skia/sk_picture/" + std::to_string(i);
+                        dump->dumpNumericValue(
+                            name.c_str(), "size", "bytes",
+                            pictureSizes[i].first);
+                        dump->dumpNumericValue(
+                            name.c_str(), "op_count", "objects",
+                            pictureSizes[i].second);
+                    }
+                    for (size_t i = 0; i < paths.size(); ++i) {
+                        auto name = "skia/sk_path/" + std::to_string(i);
+                        dump->dumpNumericValue(
+                            name.c_str(), "size", "bytes",
+                            paths[i].approximateBytesUsed());
+                    }
+                },
+                // GrDirectContext is not thread-safe, so keep the GIL for it.
+                detailed, asArrays, context == nullptr);
+        },
+        R"docstring(
+        Gathers memory used by the font cache, the resource cache, the GPU
+        resource cache of ``context``, and the given pictures and paths in one
+        pass.
+
+        Pictures and paths are reported as ``skia/sk_picture/<i>`` and
+        ``skia/sk_path/<i>`` by their index in the given lists, using their
+        approximate sizes.
+
+        With ``asArrays``, numeric values are returned as columns,
+        ``dumpName``, ``valueName``, ``units`` and a uint64 ``value`` array, so
+        that ``pandas.DataFrame(result)`` gives one row per value. String
+        values such as memory backings are only in the dict form.
+
+        Example::
+
+            stats = skia.Graphics.CollectMemoryStatistics(
+                context, pictures=[picture], asArrays=True)
+            total = stats['value'][np.array(stats['valueName']) == 'size'].sum()
+
+        :param skia.GrDirectContext context: GPU context to include; may be
+            None
+        :param List[skia.Picture] pictures: pictures to include
+        :param List[skia.Path] paths: paths to include
+        :param bool detailed: break caches down into individual entries
+        :param bool asArrays: return columns instead of a dict of dicts
+        :return: dict
+        )docstring",
+        py::arg("context") = nullptr,
+        py::arg("pictures") = std::vector<sk_sp<SkPicture>>(),
+        py::arg("paths") = std::vector<SkPath>(),
+        py::arg("detailed") = false, py::arg("asArrays") = false)
+    ;
+}
@@ -8,10 +8,16 @@
 #include <include/encode/SkPngEncoder.h>
 #include <include/encode/SkWebpEncoder.h>
 #include <include/core/SkTextureCompressionType.h>
+#include <include/core/SkImageGenerator.h>
+#include <include/core/SkYUVAPixmaps.h>
+#include <include/effects/SkColorMatrix.h>
 #include <src/core/SkMipmapBuilder.h>
+#include <src/image/SkImage_Base.h>
 
 #include <pybind11/numpy.h>
 #include <pybind11/stl.h> // std::nullopt needs this.
+#include <algorithm>
+#include <array>
 
 namespace {
 
@@ -143,11 +149,23 @@ void ImageSave(const SkImage& image, py::object fp,
 
 sk_sp<SkImage> ImageConvert(
     const SkImage& image, SkColorType ct, SkAlphaType at,
-    const SkColorSpace* cs) {
+    const SkColorSpace* cs, int threads) {
     if (ct == kUnknown_SkColorType)
         ct = image.colorType();
     if (at == kUnknown_SkAlphaType)
         at = image.alphaType();
+    SkPixmap src;
+    if (threads != 1 && image.peekPixels(&src)) {
+        auto imageInfo = SkImageInfo::Make(
+            image.width(), image.height(), ct, at, CloneColorSpace(cs));
+        auto buffer = SkData::MakeUninitialized(imageInfo.computeMinByteSize());
+        if (!buffer)
+            throw std::bad_alloc();
+        SkPixmap dst(imageInfo, buffer->writable_data(), imageInfo.minRowBytes());
+        if (!ConvertPixelsParallel(src, dst, threads))
+            throw std::runtime_error("Failed to convert pixels.");
+        return SkImages::RasterFromData(imageInfo, buffer, imageInfo.minRowBytes());
+    }
     if (at == image.alphaType()) {
         if (ct == image.colorType())
             return image.makeColorSpace(nullptr, CloneColorSpace(cs));
@@ -165,20 +183,305 @@ sk_sp<SkImage> ImageConvert(
     return SkImages::RasterFromData(imageInfo, buffer, imageInfo.minRowBytes());
 }
 
+bool ImageScalePixels(
+    const SkImage& image, const SkPixmap& dst,
+    const SkSamplingOptions& samplingOptions, SkImage::CachingHint cachingHint,
+    int threads) {
+    if (threads != 1 && !image.isTextureBacked() &&
+        ScalePixelsParallel(sk_ref_sp(&image), dst, samplingOptions, threads))
+        return true;
+    return image.scalePixels(dst, samplingOptions, cachingHint);
+}
+
 sk_sp<SkImage> ImageResize(
     const SkImage& image, int width, int height, SkSamplingOptions& samplingOptions,
-    SkImage::CachingHint cachingHint) {
+    SkImage::CachingHint cachingHint, int threads) {
     auto imageInfo = image.imageInfo().makeWH(width, height);
     auto buffer = SkData::MakeUninitialized(imageInfo.computeMinByteSize());
     if (!buffer)
         throw std::bad_alloc();
     auto pixmap = SkPixmap(
         imageInfo, buffer->writable_data(), imageInfo.minRowBytes());
-    if (!image.scalePixels(pixmap, samplingOptions, cachingHint))
+    if (!ImageScalePixels(image, pixmap, samplingOptions, cachingHint, threads))
         throw std::runtime_error("Failed to resize image.");
     return SkImages::RasterFromData(imageInfo, buffer, imageInfo.minRowBytes());
 }
 
+py::list ImageBuildPyramid(
+    const SkImage& image, int levels, const SkSamplingOptions& sampling,
+    int threads, bool asArray) {
+    if (levels < 0)
+        throw py::value_error("levels must be 0 or more.");
+
+    // Halve each dimension per level, as mipmaps do, until 1x1.
+    std::vector<SkImageInfo> infos;
+    std::vector<size_t> offsets;
+    size_t totalBytes = 0;
+    SkISize size = image.dimensions();
+    while ((size.width() > 1 || size.height() > 1) &&
+           (levels == 0 || static_cast<int>(infos.size()) < levels)) {
+        size = SkISize::Make(std::max(1, size.width() / 2),
+                             std::max(1, size.height() / 2));
+        infos.push_back(image.imageInfo().makeDimensions(size));
+        offsets.push_back(totalBytes);
+        totalBytes += infos.back().computeMinByteSize();
+    }
+
+    // All levels live in one allocation.
+    sk_sp<SkData> data;
+    py::array buffer;
+    char* base = nullptr;
+    if (asArray) {
+        buffer = py::array_t<uint8_t>(totalBytes);
+        base = static_cast<char*>(buffer.mutable_data());
+    } else {
+        data = SkData::MakeUninitialized(totalBytes);
+        if (!data)
+            throw std::bad_alloc();
+        base = static_cast<char*>(data->writable_data());
+    }
+
+    sk_sp<const SkImage> src = sk_ref_sp(&image);
+    for (size_t i = 0; i < infos.size(); ++i) {
+        SkPixmap dst(infos[i], base + offsets[i], infos[i].minRowBytes());
+        bool scaled = threads != 1 &&
+            ScalePixelsParallel(src, dst, sampling, threads);
+        if (!scaled && !src->scalePixels(dst, sampling))
+            throw std::runtime_error("Failed to build pyramid level.");
+        src = SkImages::RasterFromPixmap(dst, nullptr, nullptr);
+    }
+
+    py::list result;
+    for (size_t i = 0; i < infos.size(); ++i) {
+        if (asArray) {
+            auto info = ImageInfoToBufferInfo(
+                infos[i], base + offsets[i], 0, false);
+            result.append(py::array(
+                py::dtype(info), info.shape, info.strides, info.ptr, buffer));
+        } else {
+            result.append(SkImages::RasterFromData(
+                infos[i],
+                SkData::MakeSubset(
+                    data.get(), offsets[i], infos[i].computeMinByteSize()),
+                infos[i].minRowBytes()));
+        }
+    }
+    return result;
+}
+
+// One 8-bit plane shared with NumPy.
+struct YUVPlane {
+    sk_sp<SkData> data;
+    size_t rowBytes;
+};
+
+YUVPlane YUVPlaneFromArray(
+    py::array array, int width, int height, const char* name) {
+    // Planes are shared, not converted; other dtypes would need a copy.
+    if (!py::isinstance<py::array_t<uint8_t>>(array))
+        throw py::type_error(std::string(name) + " must be a uint8 array.");
+    auto plane = py::array_t<uint8_t>::ensure(array);
+    if (plane.ndim() != 2 || plane.shape(0) != height ||
+        plane.shape(1) != width)
+        throw py::value_error(py::str(
+            "{} must have shape ({}, {}).").format(name, height, width));
+    if (plane.strides(1) != 1 || plane.strides(0) < width)
+        throw py::value_error(
+            std::string(name) + " must be contiguous along rows.");
+    size_t rowBytes = plane.strides(0);
+    size_t size = rowBytes * (height - 1) + width;
+
+    // The plane keeps the array alive; the last unref may come from any thread.
+    const void* pixels = plane.data();
+    auto object = plane.release().ptr();
+    auto data = SkData::MakeWithProc(
+        pixels, size,
+        [] (const void*, void* context) {
+            py::gil_scoped_acquire gil;
+            Py_DECREF(reinterpret_cast<PyObject*>(context));
+        },
+        object);
+    return { data, rowBytes };
+}
+
+// Lazily converts Y, U, V planes to RGBA on the CPU, and hands the planes
+// as-is to GPU backends so they can convert on upload.
+class YUV420ImageGenerator : public SkImageGenerator {
+public:
+    YUV420ImageGenerator(const SkImageInfo& info, SkYUVColorSpace yuvColorSpace,
+                         std::array<YUVPlane, 3> planes, int threads)
+        : SkImageGenerator(info), fYUVColorSpace(yuvColorSpace),
+          fPlanes(std::move(planes)), fThreads(threads) {}
+
+protected:
+    bool onGetPixels(const SkImageInfo& info, void* pixels, size_t rowBytes,
+                     const Options&) override {
+        if (info.dimensions() != getInfo().dimensions())
+            return false;
+        SkPixmap dst(info, pixels, rowBytes);
+        if (info.colorType() == kRGBA_8888_SkColorType &&
+            SkColorSpace::Equals(info.colorSpace(), getInfo().colorSpace())) {
+            convert(dst);
+            return true;
+        }
+        SkBitmap bitmap;
+        if (!bitmap.tryAllocPixels(getInfo()))
+            return false;
+        convert(bitmap.pixmap());
+        return bitmap.pixmap().readPixels(dst);
+    }
+
+    bool onQueryYUVAInfo(const SkYUVAPixmapInfo::SupportedDataTypes& types,
+                         SkYUVAPixmapInfo* yuvaPixmapInfo) const override {
+        if (!types.supported(SkYUVAInfo::PlaneConfig::kY_U_V,
+                             SkYUVAPixmapInfo::DataType::kUnorm8))
+            return false;
+        SkYUVAInfo yuvaInfo(
+            getInfo().dimensions(), SkYUVAInfo::PlaneConfig::kY_U_V,
+            SkYUVAInfo::Subsampling::k420, fYUVColorSpace);
+        size_t rowBytes[SkYUVAPixmapInfo::kMaxPlanes] = {
+            fPlanes[0].rowBytes, fPlanes[1].rowBytes, fPlanes[2].rowBytes, 0 };
+        *yuvaPixmapInfo = SkYUVAPixmapInfo(
+            yuvaInfo, SkYUVAPixmapInfo::DataType::kUnorm8, rowBytes);
+        return yuvaPixmapInfo->isValid();
+    }
+
+    bool onGetYUVAPlanes(const SkYUVAPixmaps& yuvaPixmaps) override {
+        for (int i = 0; i < 3; ++i) {
+            const auto& dst = yuvaPixmaps.plane(i);
+            SkPixmap src(dst.info(), fPlanes[i].data->data(), fPlanes[i].rowBytes);
+            if (!src.readPixels(dst))
+                return false;
+        }
+        return true;
+    }
+
+private:
+    void convert(const SkPixmap& dst) const {
+        float m[20];
+        SkColorMatrix::YUVtoRGB(fYUVColorSpace).getRowMajor(m);
+        auto y = static_cast<const uint8_t*>(fPlanes[0].data->data());
+        auto u = static_cast<const uint8_t*>(fPlanes[1].data->data());
+        auto v = static_cast<const uint8_t*>(fPlanes[2].data->data());
+        ParallelForBands(dst.height(), fThreads, 64, [&] (int top, int bottom) {
+            for (int row = top; row < bottom; ++row) {
+                auto Y = y + row * fPlanes[0].rowBytes;
+                auto U = u + (row / 2) * fPlanes[1].rowBytes;
+                auto V = v + (row / 2) * fPlanes[2].rowBytes;
+                auto out = static_cast<uint8_t*>(dst.writable_addr(0, row));
+                for (int x = 0; x < dst.width(); ++x) {
+                    float yuv[3] = {
+                        Y[x] / 255.f, U[x / 2] / 255.f, V[x / 2] / 255.f };
+                    for (int c = 0; c < 3; ++c) {
+                        float value = m[c * 5] * yuv[0] + m[c * 5 + 1] * yuv[1] +
+                            m[c * 5 + 2] * yuv[2] + m[c * 5 + 3] + m[c * 5 + 4];
+                        out[4 * x + c] = static_cast<uint8_t>(
+                            std::clamp(value, 0.f, 1.f) * 255.f + .5f);
+                    }
+                    out[4 * x + 3] = 255;
+                }
+            }
+        });
+    }
+
+    SkYUVColorSpace fYUVColorSpace;
+    std::array<YUVPlane, 3> fPlanes;
+    int fThreads;
+};
+
+sk_sp<SkImage> ImageFromYUV420Arrays(
+    py::array y, py::array u, py::array v, SkYUVColorSpace yuvColorSpace,
+    const SkColorSpace* colorSpace, int threads) {
+    if (y.ndim() != 2)
+        throw py::value_error("y must be a 2-dimensional array.");
+    int height = y.shape(0), width = y.shape(1);
+    if (width <= 0 || height <= 0)
+        throw py::value_error("y must not be empty.");
+    int chromaWidth = (width + 1) / 2, chromaHeight = (height + 1) / 2;
+    std::array<YUVPlane, 3> planes = {
+        YUVPlaneFromArray(y, width, height, "y"),
+        YUVPlaneFromArray(u, chromaWidth, chromaHeight, "u"),
+        YUVPlaneFromArray(v, chromaWidth, chromaHeight, "v"),
+    };
+    auto info = SkImageInfo::Make(
+        width, height, kRGBA_8888_SkColorType, kOpaque_SkAlphaType,
+        CloneColorSpace(colorSpace));
+    return SkImages::DeferredFromGenerator(
+        std::make_unique<YUV420ImageGenerator>(
+            info, yuvColorSpace, std::move(planes), threads));
+}
+
+// Decodes lazy images to raster; other images are returned as they are. The
+// decoded pixels also go to the resource cache, so drawing the original lazy
+// image afterwards does not decode again.
+sk_sp<SkImage> ImageDecodeToRaster(const sk_sp<SkImage>& image) {
+    if (!image->isLazyGenerated())
+        return image;
+    return image->makeRasterImage(nullptr, SkImage::kAllow_CachingHint);
+}
+
+// Picture-backed images may play Python subclasses of Picture, so they are
+// decoded with the GIL held.
+bool ImageDecodeNeedsGIL(const SkImage& image) {
+    return as_IB(&image)->type() == SkImage_Base::Type::kLazyPicture;
+}
+
+sk_sp<SkImage> ImageDecode(sk_sp<SkImage> image) {
+    sk_sp<SkImage> raster;
+    if (ImageDecodeNeedsGIL(*image))
+        raster = ImageDecodeToRaster(image);
+    else {
+        py::gil_scoped_release release;
+        raster = ImageDecodeToRaster(image);
+    }
+    if (!raster)
+        throw std::runtime_error("Failed to decode an image");
+    return raster;
+}
+
+std::vector<sk_sp<SkImage>> ImagePredecode(
+    const std::vector<sk_sp<SkImage>>& images, int threads) {
+    for (auto& image : images)
+        CHECK_NOTNULL(image);
+    std::vector<sk_sp<SkImage>> rasters(images.size());
+    for (size_t i = 0; i < images.size(); ++i) {
+        if (ImageDecodeNeedsGIL(*images[i]))
+            rasters[i] = ImageDecodeToRaster(images[i]);
+    }
+    {
+        py::gil_scoped_release release;
+        ParallelFor(static_cast<int>(images.size()), threads, [&] (int i) {
+            if (!ImageDecodeNeedsGIL(*images[i]))
+                rasters[i] = ImageDecodeToRaster(images[i]);
+        });
+    }
+    for (auto& raster : rasters) {
+        if (!raster)
+            throw std::runtime_error("Failed to decode an image");
+    }
+    return rasters;
+}
+
+// The concurrent.futures.ThreadPoolExecutor behind decodeAsync, created on
+// first use and shut down at exit. The holder is never destroyed, so no
+// Python object is released after the interpreter finalizes.
+py::object ImageDecodePool() {
+    static py::object* pool = nullptr;
+    if (!pool) {
+        auto futures = py::module::import("concurrent.futures");
+        pool = new py::object(futures.attr("ThreadPoolExecutor")(
+            py::arg("thread_name_prefix") = "skia-decode"));
+        py::module::import("atexit").attr("register")(pool->attr("shutdown"));
+    }
+    return *pool;
+}
+
+// ImageDecode releases the GIL, so decodes submitted here run in parallel.
+py::object ImageDecodeAsync(sk_sp<SkImage> image) {
+    return ImageDecodePool().attr("submit")(
+        py::cpp_function(&ImageDecode), image);
+}
+
 }  // namespace
 
 void initImage(py::module &m) {
@@ -384,6 +687,31 @@ image
         py::arg_v("colorType", kN32_SkColorType, "skia.ColorType.kN32_ColorType"),
         py::arg_v("alphaType", kUnpremul_SkAlphaType, "skia.AlphaType.kUnpremul_AlphaType"),
         py::arg("colorSpace") = nullptr, py::arg("copy") = true)
+    .def_static("FromYUV420Arrays", &ImageFromYUV420Arrays,
+        R"docstring(
+        Creates a new :py:class:`Image` from 8-bit Y, U and V planes with 4:2:0
+        chroma subsampling, such as decoded video frames.
+
+        Planes are shared without copy and kept alive by the returned
+        :py:class:`Image`. On the CPU, planes are converted to RGBA when the
+        image is first drawn or read; GPU backends upload the planes and
+        convert on the GPU.
+
+        :param numpy.ndarray y: uint8 array of shape=(height, width)
+        :param numpy.ndarray u: uint8 array of shape=((height + 1) // 2,
+            (width + 1) // 2)
+        :param numpy.ndarray v: uint8 array of the same shape as u
+        :param skia.YUVColorSpace yuvColorSpace: how YUV values are converted
+            to RGB
+        :param skia.ColorSpace colorSpace: range of colors; may be nullptr
+        :param int threads: number of threads converting to RGBA; 0 uses all
+            cores
+        :return: created :py:class:`Image`
+        )docstring",
+        py::arg("y"), py::arg("u"), py::arg("v"),
+        py::arg_v("yuvColorSpace", kRec709_SkYUVColorSpace,
+            "skia.YUVColorSpace.kRec709_YUVColorSpace"),
+        py::arg("colorSpace") = nullptr, py::arg("threads") = 1)
     .def("toarray", &ReadToNumpy<SkImage>,
         R"docstring(
         Exports a ``numpy.ndarray``.
@@ -483,11 +811,14 @@ image
             :py:attr:`~skia.kUnknown_AlphaType` is given, uses the same
             alphaType as :py:class:`Image`.
         :param colorSpace: target color space.
+        :param int threads: if not 1, raster images are converted in row
+            bands on that many threads (0 for all cores) with the GIL
+            released.
         :return: :py:class:`Image`
         )docstring",
         py::arg_v("colorType", kUnknown_SkColorType, "skia.ColorType.kUnknown_ColorType"),
         py::arg_v("alphaType", kUnknown_SkAlphaType, "skia.AlphaType.kUnknown_AlphaType"),
-        py::arg("colorSpace") = nullptr)
+        py::arg("colorSpace") = nullptr, py::arg("threads") = 1)
     .def("resize", &ImageResize,
         R"docstring(
         Creates :py:class:`Image` by scaling pixels to fit width and height.
@@ -507,16 +838,23 @@ image
         :py:attr:`~Image.CachingHint.kDisallow_CachingHint`, pixels are not
         added to the local cache.
 
+        If threads is not 1, the destination is split into row bands that are
+        resampled on that many threads (0 for all cores) with the GIL
+        released. Bands read the shared source directly, so the result
+        matches the single-threaded one.
+
         :param int width: target width
         :param int height: target height
         :param skia.SamplingOptions options: sampling options
         :param skia.Image.CachingHint cachingHint: Caching hint
+        :param int threads: number of threads; 0 uses all cores
         :return: :py:class:`Image`
         )docstring",
         py::arg("width"), py::arg("height"),
         py::arg_v("options", SkSamplingOptions(), "skia.SamplingOptions()"),
         py::arg_v("cachingHint", SkImage::kAllow_CachingHint,
-                  "skia.Image.CachingHint.kAllow_CachingHint"))
+                  "skia.Image.CachingHint.kAllow_CachingHint"),
+        py::arg("threads") = 1)
     .def("__repr__",
         [] (const SkImage& image) {
             return py::str("Image({}, {}, {}, {})").format(
@@ -1596,7 +1934,7 @@ image
     // .def("asyncRescaleAndReadPixels", &SkImage::asyncRescaleAndReadPixels)
     // .def("asyncRescaleAndReadPixelsYUV420",
     //      &SkImage::asyncRescaleAndReadPixelsYUV420)
-    .def("scalePixels", &SkImage::scalePixels,
+    .def("scalePixels", &ImageScalePixels,
         R"docstring(
         Copies :py:class:`Image` to dst, scaling pixels to fit ``dst.width()``
         and ``dst.height()``, and converting pixels to match ``dst.colorType()``
@@ -1633,16 +1971,22 @@ image
         :py:attr:`~Image.CachingHint.kDisallow_CachingHint`, pixels are not
         added to the local cache.
 
+        If threads is not 1, row bands of dst are resampled on that many
+        threads (0 for all cores) with the GIL released. Wrap a NumPy array
+        in dst to resize into a caller-provided buffer.
+
         :param skia.Pixmap dst: destination :py:class:`Pixmap`:
             :py:class:`ImageInfo`, pixels, row bytes
         :param skia.FilterQuality filterQuality: Filter quality
         :param skia.Image.CachingHint cachingHint: Caching hint
+        :param int threads: number of threads; 0 uses all cores
         :return: true if pixels are scaled to fit dst
         )docstring",
         py::arg("dst"),
         py::arg_v("samplingOptions", SkSamplingOptions(), "skia.SamplingOptions()"),
         py::arg_v("cachingHint", SkImage::kAllow_CachingHint,
-                  "skia.Image.CachingHint.kAllow_CachingHint"))
+                  "skia.Image.CachingHint.kAllow_CachingHint"),
+        py::arg("threads") = 1)
     .def("encodeToData",
         [] (SkImage& image, SkEncodedImageFormat format, int quality) {
             sk_sp<SkData> data;
@@ -1764,6 +2108,34 @@ image
         R"docstring(
         Returns true if the image has mipmap levels.
         )docstring")
+    .def("buildPyramid", &ImageBuildPyramid,
+        R"docstring(
+        Returns downsampled levels of the image, each half the size of the
+        previous one, in a single pass.
+
+        Each level is resampled from the previous level rather than from the
+        full-resolution image, so the source is read only once. All levels
+        share one allocation. If threads is not 1, every level is resampled in
+        row bands on that many threads (0 for all cores) with the GIL
+        released.
+
+        Example::
+
+            levels = image.buildPyramid(6)
+            arrays = image.buildPyramid(6, asArray=True)
+
+        :param int levels: number of levels to build; 0 builds all levels
+            down to 1x1
+        :param skia.SamplingOptions sampling: sampling used between levels
+        :param int threads: number of threads; 0 uses all cores
+        :param bool asArray: return NumPy arrays that are views into one
+            contiguous allocation, instead of :py:class:`Image`
+        :return: list of :py:class:`Image` or numpy.ndarray, largest first
+        )docstring",
+        py::arg("levels") = 0,
+        py::arg_v("sampling", SkSamplingOptions(SkFilterMode::kLinear),
+                  "skia.SamplingOptions(skia.FilterMode.kLinear)"),
+        py::arg("threads") = 1, py::arg("asArray") = false)
     .def("withDefaultMipmaps", &SkImage::withDefaultMipmaps,
         R"docstring(
         Returns an image with the same "base" pixels as the this image, but with
@@ -1933,6 +2305,40 @@ image
         )docstring",
         py::arg("bitmap").none(false),
         py::arg_v("legacyBitmapMode", SkImage::kRO_LegacyBitmapMode, "skia.Image.kRO_LegacyBitmapMode"))
+    .def("decodeAsync", &ImageDecodeAsync,
+        R"docstring(
+        Decodes a lazy image into raster form on a background thread pool.
+
+        Returns a :py:class:`concurrent.futures.Future` whose result is the
+        raster :py:class:`Image`. Images that are not lazy complete with
+        themselves. Decoded pixels are also cached, so drawing this image
+        after the future completes does not decode again.
+
+        Example::
+
+            future = skia.Image.open('photo.jpg').decodeAsync()
+            ...
+            canvas.drawImage(future.result(), 0, 0)
+
+        :return: concurrent.futures.Future
+        )docstring")
+    .def_static("predecode", &ImagePredecode,
+        R"docstring(
+        Decodes lazy images into raster form on ``threads`` threads and
+        returns the raster images in the same order.
+
+        Images that are not lazy are returned as they are. Decoded pixels are
+        also cached, so drawing the original images afterwards does not
+        decode again.
+
+        Images made by :py:meth:`MakeFromPicture` are decoded on the calling
+        thread, since their pictures may be implemented in Python.
+
+        :param List[skia.Image] images: images to decode
+        :param int threads: number of threads; 0 uses all cores
+        :return: list of raster :py:class:`Image`
+        )docstring",
+        py::arg("images"), py::arg("threads") = 1)
     .def("isLazyGenerated", &SkImage::isLazyGenerated,
         R"docstring(
         Returns true if :py:class:`Image` is backed by an image-generator or
@@ -0,0 +1,352 @@
+#include "common.h"
+#include <include/core/SkBlender.h>
+#include <include/core/SkMesh.h>
+#include <include/effects/SkRuntimeEffect.h>
+#include <include/gpu/ganesh/SkMeshGanesh.h>
+#include <pybind11/stl_bind.h>
+#include <pybind11/stl.h>
+
+PYBIND11_MAKE_OPAQUE(std::vector<SkRuntimeEffect::ChildPtr>)
+
+namespace {
+
+py::buffer_info RequestBytes(py::buffer data) {
+    auto info = data.request();
+    py::ssize_t stride = info.itemsize;
+    for (auto i = info.ndim - 1; i >= 0; --i) {
+        if (info.shape[i] > 1 && info.strides[i] != stride)
+            throw py::value_error("data must be C-contiguous.");
+        stride *= info.shape[i];
+    }
+    return info;
+}
+
+size_t ByteSize(const py::buffer_info& info) {
+    return info.size * info.itemsize;
+}
+
+template <typename Buffer>
+void UpdateBuffer(Buffer& buffer, py::buffer data, size_t offset,
+                  GrDirectContext* context) {
+    auto info = RequestBytes(data);
+    if (!buffer.update(context, info.ptr, offset, ByteSize(info)))
+        throw std::runtime_error(
+            "Failed to update buffer; offset and size must be multiples of 4 "
+            "and fit the buffer, and context must match the buffer.");
+}
+
+sk_sp<const SkData> ToUniformData(py::object uniforms) {
+    if (uniforms.is_none())
+        return nullptr;
+    if (py::isinstance<SkData>(uniforms))
+        return uniforms.cast<sk_sp<SkData>>();
+    auto info = RequestBytes(uniforms.cast<py::buffer>());
+    return SkData::MakeWithCopy(info.ptr, ByteSize(info));
+}
+
+SkMesh CheckMesh(SkMesh::Result result) {
+    if (!result.mesh.isValid())
+        throw py::value_error(result.error.c_str());
+    return result.mesh;
+}
+
+}  // namespace
+
+void initMesh(py::module &m) {
+py::class_<SkMeshSpecification, sk_sp<SkMeshSpecification>> specification(
+    m, "MeshSpecification",
+    R"docstring(
+    Describes the vertex layout and the SkSL vertex and fragment programs of a
+    :py:class:`Mesh`.
+
+    Example::
+
+        spec = skia.MeshSpecification.Make(
+            [skia.MeshSpecification.Attribute(
+                skia.MeshSpecification.Attribute.Type.kFloat2, 0, 'pos')],
+            8,
+            [],
+            """
+            Varyings main(const Attributes attrs) {
+                Varyings v;
+                v.position = attrs.pos;
+                return v;
+            }
+            """,
+            """
+            float2 main(const Varyings v, out half4 color) {
+                color = half4(1, 0, 0, 1);
+                return v.position;
+            }
+            """)
+    )docstring");
+
+py::class_<SkMeshSpecification::Attribute> attribute(specification, "Attribute");
+
+py::enum_<SkMeshSpecification::Attribute::Type>(attribute, "Type")
+    .value("kFloat", SkMeshSpecification::Attribute::Type::kFloat)
+    .value("kFloat2", SkMeshSpecification::Attribute::Type::kFloat2)
+    .value("kFloat3", SkMeshSpecification::Attribute::Type::kFloat3)
+    .value("kFloat4", SkMeshSpecification::Attribute::Type::kFloat4)
+    .value("kUByte4_unorm", SkMeshSpecification::Attribute::Type::kUByte4_unorm)
+    ;
+
+attribute
+    .def(py::init(
+        [] (SkMeshSpecification::Attribute::Type type, size_t offset,
+            const std::string& name) {
+            return SkMeshSpecification::Attribute{
+                type, offset, SkString(name) };
+        }),
+        R"docstring(
+        :param type: attribute type
+        :param int offset: byte offset of the attribute in a vertex; must be a
+            multiple of 4
+        :param str name: name of the attribute in the Attributes struct
+        )docstring",
+        py::arg("type"), py::arg("offset"), py::arg("name"))
+    .def_readwrite("type", &SkMeshSpecification::Attribute::type)
+    .def_readwrite("offset", &SkMeshSpecification::Attribute::offset)
+    .def_property_readonly("name",
+        [] (const SkMeshSpecification::Attribute& a) {
+            return std::string(a.name.c_str());
+        })
+    ;
+
+py::class_<SkMeshSpecification::Varying> varying(specification, "Varying");
+
+py::enum_<SkMeshSpecification::Varying::Type>(varying, "Type")
+    .value("kFloat", SkMeshSpecification::Varying::Type::kFloat)
+    .value("kFloat2", SkMeshSpecification::Varying::Type::kFloat2)
+    .value("kFloat3", SkMeshSpecification::Varying::Type::kFloat3)
+    .value("kFloat4", SkMeshSpecification::Varying::Type::kFloat4)
+    .value("kHalf", SkMeshSpecification::Varying::Type::kHalf)
+    .value("kHalf2", SkMeshSpecification::Varying::Type::kHalf2)
+    .value("kHalf3", SkMeshSpecification::Varying::Type::kHalf3)
+    .value("kHalf4", SkMeshSpecification::Varying::Type::kHalf4)
+    ;
+
+varying
+    .def(py::init(
+        [] (SkMeshSpecification::Varying::Type type, const std::string& name) {
+            return SkMeshSpecification::Varying{ type, SkString(name) };
+        }),
+        py::arg("type"), py::arg("name"))
+    .def_readwrite("type", &SkMeshSpecification::Varying::type)
+    .def_property_readonly("name",
+        [] (const SkMeshSpecification::Varying& v) {
+            return std::string(v.name.c_str());
+        })
+    ;
+
+specification
+    .def_static("Make",
+        [] (const std::vector<SkMeshSpecification::Attribute>& attributes,
+            size_t vertexStride,
+            const std::vector<SkMeshSpecification::Varying>& varyings,
+            const std::string& vs, const std::string& fs,
+            const SkColorSpace* colorSpace, SkAlphaType alphaType) {
+            auto result = SkMeshSpecification::Make(
+                attributes, vertexStride, varyings, SkString(vs),
+                SkString(fs), CloneColorSpace(colorSpace), alphaType);
+            if (!result.specification)
+                throw py::value_error(result.error.c_str());
+            return result.specification;
+        },
+        R"docstring(
+        Compiles a mesh specification.
+
+        :param List[skia.MeshSpecification.Attribute] attributes: vertex
+            attributes; at most 8
+        :param int vertexStride: bytes per vertex; a multiple of 4
+        :param List[skia.MeshSpecification.Varying] varyings: values passed
+            from the vertex to the fragment program; at most 6
+        :param str vs: SkSL vertex program
+        :param str fs: SkSL fragment program
+        :param skia.ColorSpace colorSpace: color space of the fragment output;
+            None means sRGB
+        :param skia.AlphaType alphaType: alpha type of the fragment output
+        :return: :py:class:`MeshSpecification`
+        :raises ValueError: if the programs or layout are invalid
+        )docstring",
+        py::arg("attributes"), py::arg("vertexStride"), py::arg("varyings"),
+        py::arg("vs"), py::arg("fs"), py::arg("colorSpace") = nullptr,
+        py::arg_v("alphaType", kPremul_SkAlphaType,
+            "skia.AlphaType.kPremul_AlphaType"))
+    .def("stride", &SkMeshSpecification::stride,
+        R"docstring(
+        Bytes per vertex.
+        )docstring")
+    .def("uniformSize", &SkMeshSpecification::uniformSize,
+        R"docstring(
+        Bytes of uniform data the programs expect.
+        )docstring")
+    ;
+
+py::class_<SkMesh> mesh(m, "Mesh",
+    R"docstring(
+    A mesh drawn with :py:meth:`Canvas.drawMesh`.
+
+    Unlike :py:class:`Vertices`, vertex and index data live in
+    :py:class:`Mesh.VertexBuffer` and :py:class:`Mesh.IndexBuffer` objects
+    that can be updated in place, so animating a mesh only rewrites the
+    changed bytes::
+
+        vertices = skia.Mesh.MakeVertexBuffer(positions)
+        mesh = skia.Mesh.Make(
+            spec, skia.Mesh.Mode.kTriangles, vertices, len(positions), 0,
+            None, [], skia.Rect(512, 512))
+        for frame in frames:
+            vertices.update(frame.positions)
+            canvas.drawMesh(mesh, paint)
+    )docstring");
+
+py::enum_<SkMesh::Mode>(mesh, "Mode")
+    .value("kTriangles", SkMesh::Mode::kTriangles)
+    .value("kTriangleStrip", SkMesh::Mode::kTriangleStrip)
+    ;
+
+py::class_<SkMesh::VertexBuffer, sk_sp<SkMesh::VertexBuffer>, SkRefCnt>(
+    mesh, "VertexBuffer",
+    R"docstring(
+    Vertex data of a :py:class:`Mesh`, in CPU memory or on the GPU.
+    )docstring")
+    .def("size", &SkMesh::VertexBuffer::size)
+    .def("update", &UpdateBuffer<SkMesh::VertexBuffer>,
+        R"docstring(
+        Overwrites bytes of the buffer starting at offset with data.
+
+        :param data: bytes-like object or NumPy array
+        :param int offset: byte offset into the buffer; a multiple of 4
+        :param skia.GrDirectContext context: context the buffer was made
+            with; None for CPU buffers
+        )docstring",
+        py::arg("data"), py::arg("offset") = 0, py::arg("context") = nullptr)
+    ;
+
+py::class_<SkMesh::IndexBuffer, sk_sp<SkMesh::IndexBuffer>, SkRefCnt>(
+    mesh, "IndexBuffer",
+    R"docstring(
+    Index data of a :py:class:`Mesh`, as uint16 values, in CPU memory or on
+    the GPU.
+    )docstring")
+    .def("size", &SkMesh::IndexBuffer::size)
+    .def("update", &UpdateBuffer<SkMesh::IndexBuffer>,
+        R"docstring(
+        Overwrites bytes of the buffer starting at offset with data.
+
+        :param data: bytes-like object or NumPy array of uint16
+        :param int offset: byte offset into the buffer; a multiple of 4
+        :param skia.GrDirectContext context: context the buffer was made
+            with; None for CPU buffers
+        )docstring",
+        py::arg("data"), py::arg("offset") = 0, py::arg("context") = nullptr)
+    ;
+
+mesh
+    .def_static("MakeVertexBuffer",
+        [] (py::buffer data, GrDirectContext* context) {
+            auto info = RequestBytes(data);
+            auto buffer = (context) ?
+                SkMeshes::MakeVertexBuffer(context, info.ptr, ByteSize(info)) :
+                SkMeshes::MakeVertexBuffer(info.ptr, ByteSize(info));
+            if (!buffer)
+                throw std::runtime_error("Failed to make vertex buffer.");
+            return buffer;
+        },
+        R"docstring(
+        Makes a vertex buffer initialized with a copy of data.
+
+        :param data: bytes-like object or NumPy array of vertices
+        :param skia.GrDirectContext context: GPU context to allocate the
+            buffer on; None for CPU memory
+        )docstring",
+        py::arg("data"), py::arg("context") = nullptr)
+    .def_static("MakeIndexBuffer",
+        [] (py::buffer data, GrDirectContext* context) {
+            auto info = RequestBytes(data);
+            auto buffer = (context) ?
+                SkMeshes::MakeIndexBuffer(context, info.ptr, ByteSize(info)) :
+                SkMeshes::MakeIndexBuffer(info.ptr, ByteSize(info));
+            if (!buffer)
+                throw std::runtime_error("Failed to make index buffer.");
+            return buffer;
+        },
+        R"docstring(
+        Makes an index buffer initialized with a copy of data.
+
+        :param data: bytes-like object or NumPy array of uint16 indices
+        :param skia.GrDirectContext context: GPU context to allocate the
+            buffer on; None for CPU memory
+        )docstring",
+        py::arg("data"), py::arg("context") = nullptr)
+    .def_static("Make",
+        [] (sk_sp<SkMeshSpecification> spec, SkMesh::Mode mode,
+            sk_sp<SkMesh::VertexBuffer> vertexBuffer, size_t vertexCount,
+            size_t vertexOffset, py::object uniforms,
+            std::vector<SkRuntimeEffect::ChildPtr> children,
+            const SkRect& bounds) {
+            return CheckMesh(SkMesh::Make(
+                spec, mode, vertexBuffer, vertexCount, vertexOffset,
+                ToUniformData(uniforms), SkSpan(children), bounds));
+        },
+        R"docstring(
+        Makes a mesh drawing vertexCount vertices of vertexBuffer.
+
+        :param skia.MeshSpecification spec: layout and programs
+        :param skia.Mesh.Mode mode: triangles or triangle strip
+        :param skia.Mesh.VertexBuffer vertexBuffer: vertex data
+        :param int vertexCount: number of vertices to draw
+        :param int vertexOffset: byte offset of the first vertex
+        :param uniforms: uniform values as :py:class:`Data` or bytes-like
+            object of spec.uniformSize() bytes; may be None
+        :param children: child shaders, color filters or blenders
+        :param skia.Rect bounds: bounds of the drawn vertices
+        :raises ValueError: if the arguments are inconsistent
+        )docstring",
+        py::arg("spec"), py::arg("mode"), py::arg("vertexBuffer"),
+        py::arg("vertexCount"), py::arg("vertexOffset"),
+        py::arg("uniforms"), py::arg("children"), py::arg("bounds"))
+    .def_static("MakeIndexed",
+        [] (sk_sp<SkMeshSpecification> spec, SkMesh::Mode mode,
+            sk_sp<SkMesh::VertexBuffer> vertexBuffer, size_t vertexCount,
+            size_t vertexOffset, sk_sp<SkMesh::IndexBuffer> indexBuffer,
+            size_t indexCount, size_t indexOffset, py::object uniforms,
+            std::vector<SkRuntimeEffect::ChildPtr> children,
+            const SkRect& bounds) {
+            return CheckMesh(SkMesh::MakeIndexed(
+                spec, mode, vertexBuffer, vertexCount, vertexOffset,
+                indexBuffer, indexCount, indexOffset, ToUniformData(uniforms),
+                SkSpan(children), bounds));
+        },
+        R"docstring(
+        Makes a mesh drawing indexCount indices of indexBuffer, which refer to
+        vertexCount vertices of vertexBuffer.
+
+        :param skia.MeshSpecification spec: layout and programs
+        :param skia.Mesh.Mode mode: triangles or triangle strip
+        :param skia.Mesh.VertexBuffer vertexBuffer: vertex data
+        :param int vertexCount: number of vertices indices refer to
+        :param int vertexOffset: byte offset of the first vertex
+        :param skia.Mesh.IndexBuffer indexBuffer: uint16 index data
+        :param int indexCount: number of indices to draw
+        :param int indexOffset: byte offset of the first index
+        :param uniforms: uniform values as :py:class:`Data` or bytes-like
+            object of spec.uniformSize() bytes; may be None
+        :param children: child shaders, color filters or blenders
+        :param skia.Rect bounds: bounds of the drawn vertices
+        :raises ValueError: if the arguments are inconsistent
+        )docstring",
+        py::arg("spec"), py::arg("mode"), py::arg("vertexBuffer"),
+        py::arg("vertexCount"), py::arg("vertexOffset"),
+        py::arg("indexBuffer"), py::arg("indexCount"), py::arg("indexOffset"),
+        py::arg("uniforms"), py::arg("children"), py::arg("bounds"))
+    .def("isValid", &SkMesh::isValid)
+    .def("vertexCount", &SkMesh::vertexCount)
+    .def("indexCount", &SkMesh::indexCount)
+    .def("bounds", &SkMesh::bounds)
+    .def("refSpec", &SkMesh::refSpec)
+    .def("refVertexBuffer", &SkMesh::refVertexBuffer)
+    .def("refIndexBuffer", &SkMesh::refIndexBuffer)
+    ;
+}
@@ -1,5 +1,7 @@
 #include "common.h"
+#include <include/core/SkBlender.h>
 #include <include/core/SkPathUtils.h>
+#include <include/effects/SkBlenders.h>
 #include <pybind11/operators.h>
 
 
@@ -28,9 +30,7 @@ public:
     }
 };
 
-namespace {
-
-SkPaint MakeFromDict(py::dict dict) {
+SkPaint PaintFromDict(py::dict dict) {
     SkPaint paint;
     for (auto item : dict) {
         std::string key(py::str(item.first));
@@ -92,8 +92,6 @@ SkPaint MakeFromDict(py::dict dict) {
     return paint;
 }
 
-}  // namespace
-
 
 void initPaint(py::module &m) {
 // Paint
@@ -192,7 +190,7 @@ paint
         :paint: original to copy
         )docstring",
         py::arg("paint"))
-    .def(py::init([] (py::kwargs kwargs) { return MakeFromDict(kwargs); }),
+    .def(py::init([] (py::kwargs kwargs) { return PaintFromDict(kwargs); }),
         R"docstring(
         Constructs :py:class:`Paint` with keyword arguments. See ``setXXX``
         methods for required signatures.
@@ -219,7 +217,7 @@ paint
                 Style=skia.Paint.kStroke_Style,
                 )
         )docstring")
-    .def(py::init(&MakeFromDict),
+    .def(py::init(&PaintFromDict),
         R"docstring(
         Constructs :py:class:`Paint` from python dict::
 
@@ -822,6 +820,36 @@ flattenable
         py::arg("type"), py::arg("b"))
     ;
 
+py::class_<SkBlender, sk_sp<SkBlender>, SkFlattenable>(m, "Blender",
+    R"docstring(
+    :py:class:`Blender` represents a custom blend function in the Skia pipeline.
+
+    A blender combines a source color (the result of our paint) and destination
+    color (from the canvas) into a final color. Blenders are made from a
+    :py:class:`BlendMode`, by :py:meth:`Arithmetic`, or by
+    :py:meth:`RuntimeEffect.makeBlender`.
+    )docstring")
+    .def_static("Mode", &SkBlender::Mode,
+        R"docstring(
+        Create a blender that implements the specified :py:class:`BlendMode`.
+        )docstring",
+        py::arg("mode"))
+    .def_static("Arithmetic", &SkBlenders::Arithmetic,
+        R"docstring(
+        Create a blender that implements the following:
+        ``k1 * src * dst + k2 * src + k3 * dst + k4``
+
+        :param float k1: coefficient for ``src * dst``
+        :param float k2: coefficient for ``src``
+        :param float k3: coefficient for ``dst``
+        :param float k4: constant term
+        :param bool enforcePremul: if true, the RGB channels will be clamped
+            to the calculated alpha.
+        )docstring",
+        py::arg("k1"), py::arg("k2"), py::arg("k3"), py::arg("k4"),
+        py::arg("enforcePremul"))
+    ;
+
 initColorFilter(m);
 initPathEffect(m);
 initShader(m);
@@ -1,17 +1,36 @@
 #include "common.h"
 #include <include/core/SkDrawable.h>
 #include <include/core/SkBBHFactory.h>
+#include <include/core/SkFontMgr.h>
 #include <include/core/SkPictureRecorder.h>
+#include <include/core/SkSerialProcs.h>
+#include <include/core/SkTypeface.h>
+#include <include/encode/SkPngEncoder.h>
+#include <include/utils/SkNWayCanvas.h>
+#include <src/core/SkBigPicture.h>
+#include <src/core/SkCanvasPriv.h>
+#include <src/core/SkPicturePriv.h>
+#include <src/core/SkRecordDraw.h>
+#include <src/core/SkRecords.h>
+#include <pybind11/numpy.h>
 #include <pybind11/operators.h>
+#include <pybind11/stl.h>
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <random>
+#include <unordered_map>
 
 namespace {
 
 class PyPicture : public SkPicture {
 public:
+    // AbortCallback has no binding, so Python overrides take only canvas.
     void playback(
         SkCanvas *canvas, SkPicture::AbortCallback *callback=nullptr
         ) const override {
-        PYBIND11_OVERRIDE_PURE(void, SkPicture, playback, canvas, callback);
+        PYBIND11_OVERRIDE_PURE(void, SkPicture, playback, canvas);
     }
     SkRect cullRect() const override {
         PYBIND11_OVERRIDE_PURE(SkRect, SkPicture, cullRect);
@@ -38,9 +57,460 @@ public:
     }
 };
 
+// Keeps typefaces and images shared by many pictures. Pictures serialized
+// through the store hold a 12-byte reference, {magic, store token, index},
+// in place of each asset, and are resolved from the store when deserialized.
+class PictureAssetStore {
+public:
+    PictureAssetStore() : fToken(std::random_device()()) {}
+
+    SkSerialProcs serialProcs() {
+        SkSerialProcs procs;
+        procs.fImageProc = [] (SkImage* image, void* ctx) {
+            return static_cast<PictureAssetStore*>(ctx)->addImage(image);
+        };
+        procs.fImageCtx = this;
+        procs.fTypefaceProc = [] (SkTypeface* typeface, void* ctx) {
+            return static_cast<PictureAssetStore*>(ctx)->addTypeface(typeface);
+        };
+        procs.fTypefaceCtx = this;
+        return procs;
+    }
+
+    SkDeserialProcs deserialProcs() {
+        SkDeserialProcs procs;
+        procs.fImageProc = [] (const void* data, size_t length, void* ctx) {
+            auto store = static_cast<PictureAssetStore*>(ctx);
+            return store->find(store->fImages, kImageMagic, data, length);
+        };
+        procs.fImageCtx = this;
+        // Pictures pass a pointer to the stream holding the typeface instead
+        // of its data; see SkPictureData::parseStreamTag().
+        procs.fTypefaceProc = [] (const void* data, size_t length, void* ctx) {
+            auto store = static_cast<PictureAssetStore*>(ctx);
+            SkStream* stream;
+            char reference[kReferenceSize];
+            if (length != sizeof(stream))
+                return store->find(
+                    store->fTypefaces, kTypefaceMagic, data, length);
+            std::memcpy(&stream, data, sizeof(stream));
+            if (stream->read(reference, sizeof(reference)) != sizeof(reference))
+                return sk_sp<SkTypeface>();
+            return store->find(store->fTypefaces, kTypefaceMagic, reference,
+                               sizeof(reference));
+        };
+        procs.fTypefaceCtx = this;
+        return procs;
+    }
+
+    size_t typefaceCount() {
+        std::lock_guard<std::mutex> lock(fMutex);
+        return fTypefaces.assets.size();
+    }
+
+    size_t imageCount() {
+        std::lock_guard<std::mutex> lock(fMutex);
+        return fImages.assets.size();
+    }
+
+    sk_sp<SkData> serialize() {
+        std::vector<sk_sp<SkTypeface>> typefaces;
+        std::vector<sk_sp<SkData>> images;
+        {
+            std::lock_guard<std::mutex> lock(fMutex);
+            typefaces = fTypefaces.assets;
+            images = fEncodedImages;
+        }
+        SkDynamicMemoryWStream stream;
+        stream.write32(kStoreMagic);
+        stream.write32(fToken);
+        stream.write32(typefaces.size());
+        for (auto& typeface : typefaces)
+            WriteBlock(&stream, typeface->serialize(
+                SkTypeface::SerializeBehavior::kDoIncludeData));
+        stream.write32(images.size());
+        for (auto& image : images)
+            WriteBlock(&stream, image);
+        return stream.detachAsData();
+    }
+
+    static std::unique_ptr<PictureAssetStore> MakeFromData(const SkData& data) {
+        SkMemoryStream stream(data.data(), data.size());
+        uint32_t magic, count;
+        auto store = std::make_unique<PictureAssetStore>();
+        if (!stream.readU32(&magic) || magic != kStoreMagic ||
+            !stream.readU32(&store->fToken) || !stream.readU32(&count))
+            return nullptr;
+        auto fontMgr = SkFontMgr_RefDefault();
+        for (uint32_t i = 0; i < count; ++i) {
+            auto block = ReadBlock(&stream);
+            if (!block)
+                return nullptr;
+            SkMemoryStream typefaceStream(block);
+            auto typeface = SkTypeface::MakeDeserialize(&typefaceStream, fontMgr);
+            if (!typeface)
+                return nullptr;
+            store->fTypefaces.add(std::move(typeface));
+        }
+        if (!stream.readU32(&count))
+            return nullptr;
+        for (uint32_t i = 0; i < count; ++i) {
+            auto block = ReadBlock(&stream);
+            auto image = (block) ?
+                SkImages::DeferredFromEncodedData(block) : nullptr;
+            if (!image)
+                return nullptr;
+            store->fImages.add(std::move(image));
+            store->fEncodedImages.push_back(std::move(block));
+        }
+        return store;
+    }
+
+private:
+    static constexpr uint32_t kStoreMagic = SkSetFourByteTag('s', 'k', 'a', 's');
+    static constexpr uint32_t kTypefaceMagic =
+        SkSetFourByteTag('s', 'k', 't', 'f');
+    static constexpr uint32_t kImageMagic = SkSetFourByteTag('s', 'k', 'i', 'm');
+    static constexpr size_t kReferenceSize = 3 * sizeof(uint32_t);
+
+    // Assets in the order they were added, and their indices by unique ID.
+    template <typename T>
+    struct Assets {
+        std::vector<sk_sp<T>> assets;
+        std::unordered_map<uint32_t, uint32_t> indices;
+
+        uint32_t add(sk_sp<T> asset) {
+            auto it = indices.find(asset->uniqueID());
+            if (it != indices.end())
+                return it->second;
+            uint32_t index = assets.size();
+            indices[asset->uniqueID()] = index;
+            assets.push_back(std::move(asset));
+            return index;
+        }
+    };
+
+    sk_sp<SkData> reference(uint32_t magic, uint32_t index) const {
+        uint32_t reference[] = { magic, fToken, index };
+        return SkData::MakeWithCopy(reference, sizeof(reference));
+    }
+
+    sk_sp<SkData> addTypeface(SkTypeface* typeface) {
+        std::lock_guard<std::mutex> lock(fMutex);
+        return reference(kTypefaceMagic, fTypefaces.add(sk_ref_sp(typeface)));
+    }
+
+    // Images are encoded when added, so serialize() only writes images that
+    // MakeFromData() can read back. Images that cannot be encoded, e.g.
+    // texture-backed ones, are left to the default serialization.
+    sk_sp<SkData> addImage(SkImage* image) {
+        {
+            std::lock_guard<std::mutex> lock(fMutex);
+            auto it = fImages.indices.find(image->uniqueID());
+            if (it != fImages.indices.end())
+                return reference(kImageMagic, it->second);
+        }
+        auto encoded = EncodeImage(*image);
+        if (!encoded || encoded->isEmpty())
+            return nullptr;
+        std::lock_guard<std::mutex> lock(fMutex);
+        auto index = fImages.add(sk_ref_sp(image));
+        if (index == fEncodedImages.size())
+            fEncodedImages.push_back(std::move(encoded));
+        return reference(kImageMagic, index);
+    }
+
+    template <typename T>
+    sk_sp<T> find(const Assets<T>& assets, uint32_t magic, const void* data,
+                  size_t length) {
+        uint32_t reference[3];
+        if (length != sizeof(reference))
+            return nullptr;
+        std::memcpy(reference, data, sizeof(reference));
+        std::lock_guard<std::mutex> lock(fMutex);
+        if (reference[0] != magic || reference[1] != fToken ||
+            reference[2] >= assets.assets.size())
+            return nullptr;
+        return assets.assets[reference[2]];
+    }
+
+    static sk_sp<SkData> EncodeImage(const SkImage& image) {
+        if (auto encoded = image.refEncodedData())
+            return encoded;
+        auto raster = image.makeRasterImage(nullptr);
+        return (raster) ? SkPngEncoder::Encode(nullptr, raster.get(), {}) :
+                          nullptr;
+    }
+
+    static void WriteBlock(SkWStream* stream, const sk_sp<SkData>& data) {
+        size_t size = (data) ? data->size() : 0;
+        stream->write32(size);
+        if (size)
+            stream->write(data->data(), size);
+    }
+
+    static sk_sp<SkData> ReadBlock(SkStream* stream) {
+        uint32_t size;
+        if (!stream->readU32(&size) || size == 0)
+            return nullptr;
+        auto data = SkData::MakeUninitialized(size);
+        if (stream->read(data->writable_data(), size) != size)
+            return nullptr;
+        return data;
+    }
+
+    std::mutex fMutex;
+    uint32_t fToken;
+    Assets<SkTypeface> fTypefaces;
+    Assets<SkImage> fImages;
+    std::vector<sk_sp<SkData>> fEncodedImages;  // In fImages order.
+};
+
+// Plays ops whose bounds intersect any of the rects, each once and in
+// recording order, clipped to the union of the rects. Pictures without a BBH
+// are played whole under the same clip.
+int PicturePlaybackRegions(const SkPicture& picture, SkCanvas* canvas,
+                           const std::vector<SkRect>& rects) {
+    CHECK_NOTNULL(canvas);
+    SkPath clip;
+    for (auto& rect : rects)
+        clip.addRect(rect);
+    if (clip.isEmpty())
+        return 0;
+
+    SkAutoCanvasRestore restore(canvas, true);
+    canvas->clipPath(clip);
+    auto big = SkPicturePriv::AsSkBigPicture(sk_ref_sp(&picture));
+    if (!big || !big->bbh()) {
+        picture.playback(canvas);
+        return picture.approximateOpCount();
+    }
+
+    std::vector<int> ops, found;
+    for (auto& rect : rects) {
+        found.clear();
+        big->bbh()->search(rect, &found);
+        ops.insert(ops.end(), found.begin(), found.end());
+    }
+    std::sort(ops.begin(), ops.end());
+    ops.erase(std::unique(ops.begin(), ops.end()), ops.end());
+
+    SkRecords::Draw draw(canvas, big->drawablePicts(), nullptr,
+                         big->drawableCount());
+    for (int op : ops)
+        big->record()->visit(op, draw);
+    return static_cast<int>(ops.size());
+}
+
+// Returns the ops of a recorded picture, or nullptr for empty pictures and
+// Python subclasses.
+const SkRecord* PictureRecord(const SkPicture& picture) {
+    auto big = SkPicturePriv::AsSkBigPicture(sk_ref_sp(&picture));
+    return big ? big->record() : nullptr;
+}
+
+std::vector<SkRect> PictureRecordBounds(const SkPicture& picture,
+                                        const SkRecord& record) {
+    std::vector<SkRect> bounds(record.count());
+    std::vector<SkBBoxHierarchy::Metadata> meta(record.count());
+    SkRecordFillBounds(picture.cullRect(), record, bounds.data(), meta.data());
+    return bounds;
+}
+
+// Type and size of an op, including the points of its path or vertices.
+// Shared data such as images and text blobs is not counted.
+struct OpSize {
+    template <typename T>
+    std::pair<SkRecords::Type, size_t> operator()(const T& op) {
+        return { T::kType, sizeof(T) + extraBytes(op, 0) };
+    }
+
+    template <typename T>
+    static auto extraBytes(const T& op, int)
+        -> decltype(op.path.approximateBytesUsed()) {
+        return op.path.approximateBytesUsed();
+    }
+
+    template <typename T>
+    static auto extraBytes(const T& op, int)
+        -> decltype(op.vertices->approximateSize()) {
+        return op.vertices->approximateSize();
+    }
+
+    template <typename T>
+    static size_t extraBytes(const T&, long) { return 0; }
+};
+
+py::dict PictureOpStats(const SkPicture& picture) {
+    static const char* kNames[] = {
+#define NAME(T) #T,
+        SK_RECORD_TYPES(NAME)
+#undef NAME
+    };
+    struct Stats {
+        size_t count = 0;
+        size_t bytes = 0;
+        double area = 0;
+    };
+
+    auto record = PictureRecord(picture);
+    if (!record)
+        return py::dict();
+    auto bounds = PictureRecordBounds(picture, *record);
+    std::map<SkRecords::Type, Stats> stats;
+    for (int i = 0; i < record->count(); ++i) {
+        auto [type, bytes] = record->visit(i, OpSize());
+        auto& entry = stats[type];
+        entry.count += 1;
+        entry.bytes += bytes;
+        entry.area += static_cast<double>(bounds[i].width()) *
+                      bounds[i].height();
+    }
+
+    py::dict result;
+    for (auto& [type, entry] : stats)
+        result[kNames[type]] = py::dict(
+            py::arg("count") = entry.count,
+            py::arg("bytes") = entry.bytes,
+            py::arg("area") = entry.area);
+    return result;
+}
+
+py::array_t<float> PictureOpBounds(const SkPicture& picture) {
+    static_assert(sizeof(SkRect) == 4 * sizeof(float), "SkRect layout");
+    std::vector<SkRect> bounds;
+    if (auto record = PictureRecord(picture))
+        bounds = PictureRecordBounds(picture, *record);
+    py::array_t<float> array(std::vector<py::ssize_t>{
+        static_cast<py::ssize_t>(bounds.size()), 4});
+    if (!bounds.empty())
+        std::memcpy(array.mutable_data(), bounds.data(),
+                    bounds.size() * sizeof(SkRect));
+    return array;
+}
+
+// Forwards drawing to a recording canvas, playing nested pictures inline
+// instead of recording DrawPicture.
+class FlatteningCanvas : public SkNWayCanvas {
+public:
+    FlatteningCanvas(SkCanvas* canvas, const SkRect& bounds)
+        : SkNWayCanvas(1, 1) {
+        // Cover the whole cull rect, including negative coordinates, so that
+        // quick rejects and BBH searches of nested pictures keep all of it.
+        this->resetCanvas(bounds.roundOut());
+        this->addCanvas(canvas);
+    }
+
+protected:
+    void onDrawPicture(const SkPicture* picture, const SkMatrix* matrix,
+                       const SkPaint* paint) override {
+        SkAutoCanvasMatrixPaint acmp(this, matrix, paint, picture->cullRect());
+        picture->playback(this);
+    }
+};
+
+// Flattens nested pictures, then re-records without draws that are outside
+// the cull rect or clipped out. The recorder's SkRecordOptimize() pass then
+// removes save/restore pairs left empty, along with other no-op state.
+sk_sp<SkPicture> PictureOptimize(const SkPicture& picture,
+                                 sk_sp<SkBBoxHierarchy> bbh) {
+    auto cull = picture.cullRect();
+    auto flat = PictureFlatten(picture);
+    auto big = SkPicturePriv::AsSkBigPicture(flat);
+    if (!big)
+        return flat;
+
+    auto record = big->record();
+    std::vector<SkRect> bounds(record->count());
+    std::vector<SkBBoxHierarchy::Metadata> meta(record->count());
+    SkRecordFillBounds(cull, *record, bounds.data(), meta.data());
+
+    SkPictureRecorder recorder;
+    auto canvas = recorder.beginRecording(cull, std::move(bbh));
+    SkRecords::Draw draw(canvas, big->drawablePicts(), nullptr,
+                         big->drawableCount());
+    for (int i = 0; i < record->count(); ++i) {
+        if (meta[i].isDraw && bounds[i].isEmpty())
+            continue;
+        record->visit(i, draw);
+    }
+    return recorder.finishRecordingAsPicture();
+}
+
 }  // namespace
 
+sk_sp<SkPicture> PictureFlatten(const SkPicture& picture) {
+    auto cull = picture.cullRect();
+    SkPictureRecorder recorder;
+    {
+        FlatteningCanvas canvas(recorder.beginRecording(cull), cull);
+        picture.playback(&canvas);
+    }
+    return recorder.finishRecordingAsPicture();
+}
+
 void initPicture(py::module &m) {
+py::class_<PictureAssetStore>(m, "PictureAssetStore", R"docstring(
+    Shares typefaces and images among many serialized pictures.
+
+    :py:meth:`Picture.serialize` with a store writes a small reference in
+    place of each typeface and image, and adds the asset to the store once.
+    :py:meth:`Picture.MakeFromData` with the same store, or one restored by
+    :py:meth:`MakeFromData`, resolves the references without decoding assets
+    again. Assets are matched by their unique IDs, so pictures recorded from
+    the same :py:class:`Typeface` and :py:class:`Image` objects share them.
+
+    Example::
+
+        store = skia.PictureAssetStore()
+        tiles = [picture.serialize(store) for picture in pictures]
+        with open('assets.bin', 'wb') as f:
+            f.write(store.serialize())
+        ...
+        store = skia.PictureAssetStore.MakeFromData(skia.Data(assets))
+        picture = skia.Picture.MakeFromData(tiles[0], store)
+    )docstring")
+    .def(py::init())
+    .def("typefaceCount", &PictureAssetStore::typefaceCount,
+        R"docstring(
+        Returns the number of distinct typefaces in the store.
+        )docstring")
+    .def("imageCount", &PictureAssetStore::imageCount,
+        R"docstring(
+        Returns the number of distinct images in the store.
+        )docstring")
+    .def("serialize",
+        [] (PictureAssetStore& store) {
+            py::gil_scoped_release release;
+            return store.serialize();
+        },
+        R"docstring(
+        Returns the typefaces, with their font data, and the images, encoded,
+        as :py:class:`Data` for :py:meth:`MakeFromData`.
+
+        Images without encoded data are encoded as PNG.
+        )docstring")
+    .def_static("MakeFromData",
+        [] (const SkData& data) {
+            std::unique_ptr<PictureAssetStore> store;
+            {
+                py::gil_scoped_release release;
+                store = PictureAssetStore::MakeFromData(data);
+            }
+            if (!store)
+                throw py::value_error("Invalid data");
+            return store;
+        },
+        R"docstring(
+        Restores a store written by :py:meth:`serialize`.
+
+        Images are decoded when first drawn.
+
+        :param skia.Data data: serialized store
+        )docstring",
+        py::arg("data"))
+    ;
+
 py::class_<SkPicture, PyPicture, sk_sp<SkPicture>, SkRefCnt>(
     m, "Picture", R"docstring(
     :py:class:`Picture` records drawing commands made to :py:class:`Canvas`.
@@ -66,6 +536,12 @@ py::class_<SkPicture, PyPicture, sk_sp<SkPicture>, SkRefCnt>(
         canvas.drawLine(0, 0, 100, 100, skia.Paint())
         picture = recorder.finishRecordingAsPicture()
     )docstring")
+    .def(py::init_alias<>(),
+        R"docstring(
+        Constructs a :py:class:`Picture` subclass implemented in Python, which
+        must override :py:meth:`playback`, :py:meth:`cullRect`,
+        :py:meth:`approximateOpCount` and :py:meth:`approximateBytesUsed`.
+        )docstring")
     .def(py::init(&SkPicture::MakePlaceholder),
         R"docstring(
         Returns a placeholder :py:class:`Picture`.
@@ -97,6 +573,60 @@ py::class_<SkPicture, PyPicture, sk_sp<SkPicture>, SkRefCnt>(
         :param callback: allows interruption of playback
         )docstring",
         py::arg("canvas"))
+    .def("playbackRegions", &PicturePlaybackRegions,
+        R"docstring(
+        Replays only the drawing commands that intersect ``rects``.
+
+        The bounding box hierarchy of the picture is searched once per rect,
+        and commands found by several rects are played once, in recording
+        order, clipped to the union of ``rects``. Pictures recorded without a
+        :py:class:`BBoxHierarchy` are played whole under the same clip.
+
+        Example::
+
+            recorder = skia.PictureRecorder()
+            canvas = recorder.beginRecording(
+                skia.Rect(1024, 1024), skia.RTreeFactory()())
+            ...
+            picture = recorder.finishRecordingAsPicture()
+            picture.playbackRegions(surface.getCanvas(), dirty_rects)
+
+        :param skia.Canvas canvas: receiver of drawing commands
+        :param List[skia.Rect] rects: areas to redraw, in picture coordinates
+        :return: number of commands played
+        )docstring",
+        py::arg("canvas"), py::arg("rects"))
+    .def("opStats", &PictureOpStats,
+        R"docstring(
+        Returns counts, sizes and covered areas of recorded commands by type.
+
+        The result maps each command type, such as ``'DrawRect'`` or
+        ``'SaveLayer'``, to a dict of:
+
+        - ``count``: number of commands
+        - ``bytes``: size of the commands, including points of their paths and
+          vertices; shared data such as images and text blobs is not counted
+        - ``area``: sum of the areas of their bounds as in :py:meth:`opBounds`,
+          a rough estimate of the pixels they touch
+
+        Nested pictures count as one ``DrawPicture`` command. Empty pictures
+        and pictures implemented in Python return an empty dict.
+
+        :return: dict of dicts
+        )docstring")
+    .def("opBounds", &PictureOpBounds,
+        R"docstring(
+        Returns the bounds of each recorded command, in recording order.
+
+        Bounds are in picture coordinates, limited to :py:meth:`cullRect`.
+        Commands that do not draw, such as ``Save`` or ``ClipRect``, get the
+        bounds of the commands they affect. These are the bounds a
+        :py:class:`BBoxHierarchy` is built from.
+
+        :return: float32 array of shape (N, 4) holding left, top, right and
+            bottom
+        :rtype: numpy.ndarray
+        )docstring")
     .def("cullRect", &SkPicture::cullRect,
         R"docstring(
         Returns cull :py:class:`Rect` for this picture, passed in when
@@ -125,6 +655,19 @@ py::class_<SkPicture, PyPicture, sk_sp<SkPicture>, SkRefCnt>(
 
         :return: storage containing serialized :py:class:`Picture`
         )docstring")
+    .def("serialize",
+        [] (SkPicture& picture, PictureAssetStore& store) {
+            auto procs = store.serialProcs();
+            return picture.serialize(&procs);
+        },
+        R"docstring(
+        Returns storage containing :py:class:`Data` describing
+        :py:class:`Picture`, with typefaces and images moved to ``store``.
+
+        :param skia.PictureAssetStore store: store that keeps the assets
+        :return: storage containing serialized :py:class:`Picture`
+        )docstring",
+        py::arg("store"))
     .def("approximateOpCount", &SkPicture::approximateOpCount,
         R"docstring(
         Returns the approximate number of operations in :py:class:`Picture`.
@@ -136,6 +679,32 @@ py::class_<SkPicture, PyPicture, sk_sp<SkPicture>, SkRefCnt>(
         :return: approximate operation count
         )docstring",
         py::arg("nested") = false)
+    .def("optimize",
+        [] (const SkPicture& picture, sk_sp<SkBBoxHierarchy> bbh) {
+            return PictureOptimize(picture, bbh);
+        },
+        R"docstring(
+        Returns a new :py:class:`Picture` that draws the same, with fewer
+        commands.
+
+        Nested pictures are played inline, so their commands are optimized
+        together with the rest. Commands that draw outside :py:meth:`cullRect`
+        or are clipped out are dropped. Then the optimizations of
+        :py:meth:`PictureRecorder.finishRecordingAsPicture` remove
+        save/restore pairs left with nothing in between, and other state
+        changes that do not affect drawing.
+
+        Example::
+
+            optimized = picture.optimize(skia.RTreeFactory()())
+            print(picture.approximateOpCount(True),
+                  optimized.approximateOpCount(True))
+
+        :param skia.BBoxHierarchy bbh: bounding box hierarchy to build for
+            the new picture; may be None
+        :return: optimized :py:class:`Picture`
+        )docstring",
+        py::arg("bbh") = nullptr)
     .def("approximateBytesUsed", &SkPicture::approximateBytesUsed,
         R"docstring(
         Returns the approximate byte size of :py:class:`Picture`.
@@ -198,9 +767,27 @@ py::class_<SkPicture, PyPicture, sk_sp<SkPicture>, SkRefCnt>(
         :raise: ValueError
         )docstring",
         py::arg("data"))
-    // .def_static("MakeFromData",
-    //     py::overload_cast<const void*, size_t, const SkDeserialProcs*>(
-    //         &SkPicture::MakeFromData))
+    .def_static("MakeFromData",
+        [] (const SkData* data, PictureAssetStore& store) {
+            CHECK_NOTNULL(data);
+            auto procs = store.deserialProcs();
+            auto picture = SkPicture::MakeFromData(
+                data->data(), data->size(), &procs);
+            if (!picture)
+                throw py::value_error("Invalid data");
+            return picture;
+        },
+        R"docstring(
+        Recreates :py:class:`Picture` serialized with ``store``.
+
+        Typefaces and images are taken from ``store``, which must be the store
+        used by :py:meth:`serialize` or one restored from it.
+
+        :param skia.Data data: serialized picture
+        :param skia.PictureAssetStore store: store that keeps the assets
+        :return: :py:class:`Picture` constructed from data
+        )docstring",
+        py::arg("data"), py::arg("store"))
     .def_static("MakePlaceholder", &SkPicture::MakePlaceholder,
         R"docstring(
         Returns a placeholder :py:class:`Picture`.
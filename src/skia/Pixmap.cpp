@@ -496,6 +496,58 @@ py::class_<SkPixmap>(m, "Pixmap",
         :return: writable generic base pointer to pixels
         :rtype: memoryview
         )docstring")
+    .def("convertTo",
+        [] (const SkPixmap& pixmap, py::array dst, SkColorType colorType,
+            SkAlphaType alphaType, const SkColorSpace* colorSpace,
+            int threads) {
+            if (!dst.writeable())
+                throw py::value_error("dst must be writeable.");
+            if (colorType == kUnknown_SkColorType)
+                colorType = pixmap.colorType();
+            if (alphaType == kUnknown_SkAlphaType)
+                alphaType = pixmap.alphaType();
+            auto imageInfo = NumPyToImageInfo(
+                dst, colorType, alphaType, colorSpace);
+            if (imageInfo.dimensions() != pixmap.dimensions())
+                throw py::value_error(py::str(
+                    "dst must have shape ({}, {}, ...).").format(
+                    pixmap.height(), pixmap.width()));
+            SkPixmap dstPixmap(imageInfo, dst.mutable_data(), dst.strides(0));
+            if (!ConvertPixelsParallel(pixmap, dstPixmap, threads))
+                throw std::runtime_error("Failed to convert pixels.");
+            return dst;
+        },
+        R"docstring(
+        Converts all pixels into the numpy array dst, in
+        :py:class:`ColorType` colorType, :py:class:`AlphaType` alphaType and
+        :py:class:`ColorSpace` colorSpace.
+
+        Rows are converted in bands on `threads` threads (0 for all cores)
+        with the GIL released, directly into dst without an intermediate
+        :py:class:`Image`. Raises if the conversion is not possible; see
+        :py:meth:`readPixels`.
+
+        Example::
+
+            dst = np.empty((pixmap.height(), pixmap.width(), 4), np.float16)
+            pixmap.convertTo(dst, skia.kRGBA_F16_ColorType)
+
+        :param numpy.ndarray dst: C-contiguous array of shape (height, width,
+            ...) matching colorType
+        :param skia.ColorType colorType: destination color type; kUnknown keeps
+            the source color type
+        :param skia.AlphaType alphaType: destination alpha type; kUnknown keeps
+            the source alpha type
+        :param skia.ColorSpace colorSpace: destination color space
+        :param int threads: number of threads; 0 uses all cores
+        :return: dst
+        )docstring",
+        py::arg("dst"),
+        py::arg_v("colorType", kUnknown_SkColorType,
+            "skia.ColorType.kUnknown_ColorType"),
+        py::arg_v("alphaType", kUnknown_SkAlphaType,
+            "skia.AlphaType.kUnknown_AlphaType"),
+        py::arg("colorSpace") = nullptr, py::arg("threads") = 1)
     .def("readPixels", &ReadPixels<SkPixmap>,
         R"docstring(
         Copies :py:class:`Rect` of pixels to dstPixels.
@@ -578,7 +630,15 @@ py::class_<SkPixmap>(m, "Pixmap",
         :return: true if pixels are copied to dst
         )docstring",
         py::arg("dst"), py::arg("srcX") = 0, py::arg("srcY") = 0)
-    .def("scalePixels", &SkPixmap::scalePixels,
+    .def("scalePixels",
+        [] (const SkPixmap& pixmap, const SkPixmap& dst,
+            const SkSamplingOptions& samplingOptions, int threads) {
+            if (threads != 1 && ScalePixelsParallel(
+                    SkImages::RasterFromPixmap(pixmap, nullptr, nullptr), dst,
+                    samplingOptions, threads))
+                return true;
+            return pixmap.scalePixels(dst, samplingOptions);
+        },
         R"docstring(
         Copies :py:class:`Pixmap` to dst, scaling pixels to fit ``dst.width()``
         and ``dst.height()``, and converting pixels to match ``dst.colorType()``
@@ -613,13 +673,18 @@ py::class_<SkPixmap>(m, "Pixmap",
         is reduced. :py:attr:`~FilterQuality.kHigh_FilterQuality` is slowest,
         typically implemented with bicubic filter.
 
+        If threads is not 1, row bands of dst are resampled on that many
+        threads (0 for all cores) with the GIL released.
+
         :param skia.Pixmap dst: destination :py:class:`Pixmap`:
             :py:class:`ImageInfo`, pixels, row bytes
         :param skia.SamplingOptions options: sampling options
+        :param int threads: number of threads; 0 uses all cores
         :return: true if pixels are scaled to fit dst
         )docstring",
         py::arg("dst"),
-        py::arg_v("samplingOptions", SkSamplingOptions(), "skia.SamplingOptions()"))
+        py::arg_v("samplingOptions", SkSamplingOptions(), "skia.SamplingOptions()"),
+        py::arg("threads") = 1)
     .def("erase",
         py::overload_cast<const SkColor4f&, const SkIRect*>(
             &SkPixmap::erase, py::const_),
@@ -2,11 +2,340 @@
 #include "common.h"
 #include <include/effects/SkRuntimeEffect.h>
 //#include <include/core/SkM44.h> // defines SkV2, SkV3, SkV4 ; M44 used in Matrix/Canvas ; Revisit.
+#include <pybind11/numpy.h>
 #include <pybind11/stl_bind.h>
 #include <pybind11/stl.h> // for std::optional<>
+#include <chrono>
+#include <cstring>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
 
 PYBIND11_MAKE_OPAQUE(std::vector<SkRuntimeEffect::ChildPtr>)
 
+namespace {
+
+bool IsIntUniform(SkRuntimeEffect::Uniform::Type type) {
+    switch (type) {
+        case SkRuntimeEffect::Uniform::Type::kInt:
+        case SkRuntimeEffect::Uniform::Type::kInt2:
+        case SkRuntimeEffect::Uniform::Type::kInt3:
+        case SkRuntimeEffect::Uniform::Type::kInt4:
+            return true;
+        default:
+            return false;
+    }
+}
+
+/*
+  Uniform storage laid out per effect.uniforms() offsets. The data is shared
+  with shaders made from it, so a write while a shader still holds on to it
+  has to move to other storage for that shader to keep its snapshot. Two
+  buffers are kept for this: in the usual per-frame pattern the shader from
+  two frames back is gone by the next write, and its buffer is reused instead
+  of allocating a new one. Only the uniform bytes themselves are copied.
+*/
+class UniformBuffer {
+public:
+    explicit UniformBuffer(sk_sp<SkRuntimeEffect> effect)
+        : fEffect(std::move(effect)),
+          fData(SkData::MakeZeroInitialized(fEffect->uniformSize())) {}
+
+    const sk_sp<SkRuntimeEffect>& effect() const { return fEffect; }
+
+    size_t size() const { return fEffect->uniforms().size(); }
+
+    int indexOf(std::string_view name) const {
+        auto uniforms = fEffect->uniforms();
+        for (size_t i = 0; i < uniforms.size(); ++i) {
+            if (uniforms[i].name == name)
+                return static_cast<int>(i);
+        }
+        throw py::key_error(py::str("No uniform named '{}'.").format(
+            std::string(name)));
+    }
+
+    const SkRuntimeEffect::Uniform& uniform(int index) const {
+        auto uniforms = fEffect->uniforms();
+        if (index < 0)
+            index += static_cast<int>(uniforms.size());
+        if (index < 0 || static_cast<size_t>(index) >= uniforms.size())
+            throw py::index_error(py::str("Uniform index {} out of range.")
+                .format(index));
+        return uniforms[index];
+    }
+
+    py::array get(int index) const {
+        const auto& u = this->uniform(index);
+        const char* ptr = static_cast<const char*>(fData->data()) + u.offset;
+        py::ssize_t count = u.sizeInBytes() / 4;
+        if (IsIntUniform(u.type)) {
+            py::array_t<int32_t> array(count);
+            std::memcpy(array.mutable_data(), ptr, u.sizeInBytes());
+            return std::move(array);
+        }
+        py::array_t<float> array(count);
+        std::memcpy(array.mutable_data(), ptr, u.sizeInBytes());
+        return std::move(array);
+    }
+
+    void set(int index, py::handle value) {
+        const auto& u = this->uniform(index);
+        size_t count = u.sizeInBytes() / 4;
+        char* ptr = static_cast<char*>(this->writableData()) + u.offset;
+        if (IsIntUniform(u.type)) {
+            auto array = py::array_t<int32_t,
+                py::array::c_style | py::array::forcecast>::ensure(value);
+            CheckCount(u, array, count);
+            std::memcpy(ptr, array.data(), u.sizeInBytes());
+            return;
+        }
+        auto source = py::reinterpret_borrow<py::object>(value);
+        if (py::isinstance<SkV2>(value)) {
+            auto v = value.cast<SkV2>();
+            source = py::make_tuple(v.x, v.y);
+        } else if (py::isinstance<SkV3>(value)) {
+            auto v = value.cast<SkV3>();
+            source = py::make_tuple(v.x, v.y, v.z);
+        } else if (py::isinstance<SkV4>(value)) {
+            auto v = value.cast<SkV4>();
+            source = py::make_tuple(v.x, v.y, v.z, v.w);
+        }
+        auto array = py::array_t<float,
+            py::array::c_style | py::array::forcecast>::ensure(source);
+        CheckCount(u, array, count);
+        std::memcpy(ptr, array.data(), u.sizeInBytes());
+    }
+
+    void update(py::dict values) {
+        for (auto item : values)
+            this->set(this->indexOf(item.first.cast<std::string>()),
+                      item.second);
+    }
+
+    sk_sp<SkData> data() const { return fData; }
+
+private:
+    void* writableData() {
+        if (!fData->unique()) {
+            if (fSpare && fSpare->unique()) {
+                std::memcpy(fSpare->writable_data(), fData->data(),
+                            fData->size());
+                std::swap(fData, fSpare);
+            } else {
+                fSpare = std::exchange(
+                    fData, SkData::MakeWithCopy(fData->data(), fData->size()));
+            }
+        }
+        return fData->writable_data();
+    }
+
+    static void CheckCount(const SkRuntimeEffect::Uniform& u,
+                           const py::array& array, size_t count) {
+        if (!array)
+            throw py::value_error(py::str(
+                "Uniform '{}' cannot be set from the given value.").format(
+                std::string(u.name)));
+        if (static_cast<size_t>(array.size()) != count)
+            throw py::value_error(py::str(
+                "Uniform '{}' expects {} values (given {}).").format(
+                std::string(u.name), count, array.size()));
+    }
+
+    sk_sp<SkRuntimeEffect> fEffect;
+    sk_sp<SkData> fData;
+    sk_sp<SkData> fSpare;
+};
+
+void CheckUniformBuffer(const SkRuntimeEffect& effect,
+                        const UniformBuffer& uniforms) {
+    if (uniforms.effect().get() != &effect)
+        throw py::value_error(
+            "UniformBuffer was created for a different RuntimeEffect.");
+}
+
+/*
+  Process-wide cache of compiled effects, keyed by kind and SkSL source. Only
+  the overloads without Options go through it; effects are immutable, so
+  handing out the same sk_sp<SkRuntimeEffect> is safe. At most fLimit effects
+  are kept, evicting the least recently used.
+*/
+class RuntimeEffectCache {
+public:
+    using Factory = SkRuntimeEffect::Result (*)(
+        SkString, const SkRuntimeEffect::Options&);
+
+    static RuntimeEffectCache& Get() {
+        static RuntimeEffectCache* cache = new RuntimeEffectCache();
+        return *cache;
+    }
+
+    sk_sp<SkRuntimeEffect> findOrMake(char kind, const SkString& sksl,
+                                      Factory factory) {
+        std::string key(1, kind);
+        key.append(sksl.c_str(), sksl.size());
+        {
+            std::lock_guard<std::mutex> lock(fMutex);
+            if (fEnabled) {
+                auto it = fIndex.find(key);
+                if (it != fIndex.end()) {
+                    fEntries.splice(fEntries.begin(), fEntries, it->second);
+                    ++fHits;
+                    return it->second->effect;
+                }
+            }
+        }
+        // Compile outside the lock; a racing compile of the same source only
+        // wastes work, the first result wins.
+        auto start = std::chrono::steady_clock::now();
+        auto [effect, err] = factory(sksl, SkRuntimeEffect::Options());
+        std::chrono::duration<double> elapsed =
+            std::chrono::steady_clock::now() - start;
+        if (!effect)
+            throw std::runtime_error(err.data());
+
+        std::lock_guard<std::mutex> lock(fMutex);
+        ++fMisses;
+        fCompileSeconds += elapsed.count();
+        if (!fEnabled)
+            return effect;
+        auto it = fIndex.find(key);
+        if (it != fIndex.end())
+            return it->second->effect;
+        fEntries.push_front({ key, effect });
+        fIndex[std::move(key)] = fEntries.begin();
+        trim();
+        return effect;
+    }
+
+    py::dict stats() {
+        using namespace pybind11::literals;
+        std::lock_guard<std::mutex> lock(fMutex);
+        return py::dict(
+            "hits"_a = fHits,
+            "misses"_a = fMisses,
+            "compileTime"_a = fCompileSeconds,
+            "count"_a = fEntries.size(),
+            "limit"_a = fLimit,
+            "enabled"_a = fEnabled);
+    }
+
+    void purge(bool resetStats) {
+        std::lock_guard<std::mutex> lock(fMutex);
+        fEntries.clear();
+        fIndex.clear();
+        if (resetStats) {
+            fHits = 0;
+            fMisses = 0;
+            fCompileSeconds = 0;
+        }
+    }
+
+    void setEnabled(bool enabled) {
+        std::lock_guard<std::mutex> lock(fMutex);
+        fEnabled = enabled;
+        if (!enabled) {
+            fEntries.clear();
+            fIndex.clear();
+        }
+    }
+
+    void setLimit(size_t limit) {
+        std::lock_guard<std::mutex> lock(fMutex);
+        fLimit = limit;
+        trim();
+    }
+
+private:
+    struct Entry {
+        std::string key;
+        sk_sp<SkRuntimeEffect> effect;
+    };
+
+    void trim() {
+        while (fEntries.size() > fLimit) {
+            fIndex.erase(fEntries.back().key);
+            fEntries.pop_back();
+        }
+    }
+
+    std::mutex fMutex;
+    std::list<Entry> fEntries;  // Most recently used first.
+    std::unordered_map<std::string, std::list<Entry>::iterator> fIndex;
+    size_t fLimit = 256;
+    uint64_t fHits = 0;
+    uint64_t fMisses = 0;
+    double fCompileSeconds = 0;
+    bool fEnabled = true;
+};
+
+sk_sp<SkData> UniformsToData(const SkRuntimeEffect& effect,
+                             py::object uniforms) {
+    if (uniforms.is_none())
+        return nullptr;
+    if (py::isinstance<UniformBuffer>(uniforms)) {
+        const auto& buffer = uniforms.cast<const UniformBuffer&>();
+        CheckUniformBuffer(effect, buffer);
+        return buffer.data();
+    }
+    if (py::isinstance<py::dict>(uniforms)) {
+        UniformBuffer buffer(sk_ref_sp(&effect));
+        buffer.update(uniforms.cast<py::dict>());
+        return buffer.data();
+    }
+    return uniforms.cast<sk_sp<SkData>>();
+}
+
+py::array RuntimeEffectEvaluate(
+    const SkRuntimeEffect& effect, int width, int height, py::object uniforms,
+    const std::vector<SkRuntimeEffect::ChildPtr>& children,
+    SkColorType colorType, SkAlphaType alphaType, const SkMatrix* localMatrix,
+    py::object out, int threads) {
+    if (width <= 0 || height <= 0)
+        throw py::value_error(py::str(
+            "Width and height must be greater than 0. "
+            "(width={}, height={})").format(width, height));
+    auto shader = effect.makeShader(
+        UniformsToData(effect, uniforms), SkSpan(children), localMatrix);
+    if (!shader)
+        throw std::runtime_error(
+            "Failed to make shader; check uniforms and children.");
+
+    auto imageInfo = SkImageInfo::Make(width, height, colorType, alphaType);
+    py::array array = (out.is_none()) ?
+        py::array(ImageInfoToBufferInfo(imageInfo, nullptr)) :
+        out.cast<py::array>();
+    if (!array.writeable())
+        throw py::value_error("Output array must be writeable.");
+    auto outInfo = NumPyToImageInfo(array, colorType, alphaType, nullptr);
+    if (outInfo.dimensions() != imageInfo.dimensions())
+        throw py::value_error(py::str(
+            "Output array must have shape ({}, {}, ...).").format(
+            height, width));
+    char* pixels = static_cast<char*>(array.mutable_data());
+    size_t rowBytes = array.strides(0);
+
+    SkPaint paint;
+    paint.setShader(std::move(shader));
+    paint.setBlendMode(SkBlendMode::kSrc);
+    {
+        py::gil_scoped_release release;
+        ParallelForBands(height, threads, 64, [&] (int top, int bottom) {
+            auto canvas = SkCanvas::MakeRasterDirect(
+                imageInfo.makeWH(width, bottom - top),
+                pixels + top * rowBytes, rowBytes);
+            if (!canvas)
+                return;
+            canvas->translate(0, -top);
+            canvas->drawPaint(paint);
+        });
+    }
+    return array;
+}
+
+}  // namespace
+
 void initRuntimeEffect(py::module &m) {
 py::class_<SkRuntimeEffect, sk_sp<SkRuntimeEffect>, SkRefCnt> runtime_effect(m, "RuntimeEffect");
 
@@ -21,6 +350,28 @@ py::class_<SkSpan<const SkRuntimeEffect::ChildPtr>> span_runtime_effect_childptr
 py::class_<SkSpan<SkRuntimeEffect::Uniform const>> span_runtime_effect_uniform(m, "SpanRuntimeEffectUniform");
 
 py::class_<SkRuntimeEffectBuilder> runtime_effect_builder(m, "RuntimeEffectBuilder");
+py::class_<UniformBuffer> uniform_buffer(m, "RuntimeEffectUniformBuffer", R"docstring(
+    Reusable uniform storage for a :py:class:`RuntimeEffect`.
+
+    Uniforms are addressed by name or by their index in
+    :py:meth:`RuntimeEffect.uniforms`; look the index up once with
+    :py:meth:`index` to skip the name lookup on every frame. Values are
+    written in place from scalars, sequences or NumPy arrays, and the buffer is
+    passed to :py:meth:`RuntimeEffect.makeShader` without copying.
+
+    Shaders keep the values they were made with. The buffer alternates between
+    two storage blocks for this, so writing while the previous frame's shader
+    is still alive reuses the older block rather than allocating.
+
+    Example::
+
+        uniforms = skia.RuntimeEffectUniformBuffer(effect)
+        iTime = uniforms.index('iTime')
+        uniforms['iResolution'] = (width, height, 1)
+        for t in range(frames):
+            uniforms[iTime] = t / 60.
+            paint.setShader(effect.makeShader(uniforms))
+    )docstring");
 
 py::enum_<SkRuntimeEffect::ChildType>(runtime_effect, "ChildType")
     .value("kShader",       SkRuntimeEffect::ChildType::kShader)
@@ -198,10 +549,8 @@ runtime_effect
         py::arg("sksl"), py::arg("options"))
     .def_static("MakeForColorFilter",
         [] (SkString sksl) {
-            auto [effect, err] = SkRuntimeEffect::MakeForColorFilter(sksl);
-            if (!effect)
-                throw std::runtime_error(err.data());
-            return effect;
+            return RuntimeEffectCache::Get().findOrMake(
+                'c', sksl, &SkRuntimeEffect::MakeForColorFilter);
         },
         py::arg("sksl"))
     .def_static("MakeForShader",
@@ -214,10 +563,8 @@ runtime_effect
         py::arg("sksl"), py::arg("options"))
     .def_static("MakeForShader",
         [] (SkString sksl) {
-            auto [effect, err] = SkRuntimeEffect::MakeForShader(sksl);
-            if (!effect)
-                throw std::runtime_error(err.data());
-            return effect;
+            return RuntimeEffectCache::Get().findOrMake(
+                's', sksl, &SkRuntimeEffect::MakeForShader);
         },
         py::arg("sksl"))
     .def_static("MakeForBlender",
@@ -230,12 +577,56 @@ runtime_effect
         py::arg("sksl"), py::arg("options"))
     .def_static("MakeForBlender",
         [] (SkString sksl) {
-            auto [effect, err] = SkRuntimeEffect::MakeForBlender(sksl);
-            if (!effect)
-                throw std::runtime_error(err.data());
-            return effect;
+            return RuntimeEffectCache::Get().findOrMake(
+                'b', sksl, &SkRuntimeEffect::MakeForBlender);
         },
         py::arg("sksl"))
+    .def_static("GetCacheStats",
+        [] () { return RuntimeEffectCache::Get().stats(); },
+        R"docstring(
+        Returns statistics of the compiled effect cache.
+
+        ``MakeForShader``, ``MakeForColorFilter`` and ``MakeForBlender``
+        without options return the same :py:class:`RuntimeEffect` for the same
+        SkSL source instead of compiling it again.
+
+        :return: dict with ``hits``, ``misses``, ``compileTime`` (total
+            seconds spent compiling on misses), ``count``, the entry ``limit``
+            and ``enabled``
+        )docstring")
+    .def_static("PurgeCache",
+        [] (bool resetStats) { RuntimeEffectCache::Get().purge(resetStats); },
+        R"docstring(
+        Drops all effects held by the compiled effect cache.
+
+        :param bool resetStats: also reset hit, miss and time counters
+        )docstring",
+        py::arg("resetStats") = false)
+    .def_static("SetCacheLimit",
+        [] (size_t limit) { RuntimeEffectCache::Get().setLimit(limit); },
+        R"docstring(
+        Sets the maximum number of cached effects, evicting the least recently
+        used ones. 0 keeps nothing.
+        )docstring",
+        py::arg("limit"))
+    .def_static("SetCacheEnabled",
+        [] (bool enabled) { RuntimeEffectCache::Get().setEnabled(enabled); },
+        R"docstring(
+        Enables or disables the compiled effect cache. Disabling also purges
+        it.
+        )docstring",
+        py::arg("enabled"))
+    .def("makeShader",
+        [] (SkRuntimeEffect& runtime_effect, const UniformBuffer& uniforms,
+            const std::vector<SkRuntimeEffect::ChildPtr>& children,
+            const SkMatrix* localMatrix) {
+            CheckUniformBuffer(runtime_effect, uniforms);
+            return runtime_effect.makeShader(
+                uniforms.data(), SkSpan(children), localMatrix);
+        },
+        py::arg("uniforms"),
+        py::arg("children") = std::vector<SkRuntimeEffect::ChildPtr>(),
+        py::arg("localMatrix") = nullptr)
     .def("makeShader",
         [] (SkRuntimeEffect& runtime_effect, sk_sp<const SkData> uniforms) {
             return runtime_effect.makeShader(uniforms, {});
@@ -249,6 +640,15 @@ runtime_effect
         py::overload_cast<sk_sp<const SkData>, SkSpan<const SkRuntimeEffect::ChildPtr>, const SkMatrix*>(&SkRuntimeEffect::makeShader, py::const_),
         py::arg("uniforms"), py::arg("children"),
         py::arg("localMatrix") = nullptr)
+    .def("makeColorFilter",
+        [] (SkRuntimeEffect& runtime_effect, const UniformBuffer& uniforms,
+            const std::vector<SkRuntimeEffect::ChildPtr>& children) {
+            CheckUniformBuffer(runtime_effect, uniforms);
+            return runtime_effect.makeColorFilter(
+                uniforms.data(), SkSpan(children));
+        },
+        py::arg("uniforms"),
+        py::arg("children") = std::vector<SkRuntimeEffect::ChildPtr>())
     .def("makeColorFilter",
         py::overload_cast<sk_sp<const SkData>>(&SkRuntimeEffect::makeColorFilter, py::const_),
         py::arg("uniforms"))
@@ -269,6 +669,109 @@ runtime_effect
         py::arg("uniforms"), py::arg("children") = SkSpan<const SkRuntimeEffect::ChildPtr>{})
     .def("children", &SkRuntimeEffect::children, py::return_value_policy::reference_internal) // returns SkSpan(self.fChildren)
     .def("uniforms", &SkRuntimeEffect::uniforms, py::return_value_policy::reference_internal) // returns SkSpan(self.fUniforms)
+    .def("uniformSize", &SkRuntimeEffect::uniformSize)
+    .def("evaluate", &RuntimeEffectEvaluate,
+        R"docstring(
+        Runs a shader effect on the CPU for every pixel of a width x height
+        grid and returns the result as a NumPy array.
+
+        The shader is evaluated in row bands on `threads` worker threads with
+        the GIL released. No color space conversion is applied, so values are
+        written as the SkSL main() returns them; use
+        :py:attr:`ColorType.kRGBA_F32_ColorType` to keep full precision for
+        numeric work. Evaluation is at pixel centers, as when drawing.
+
+        Example::
+
+            effect = skia.RuntimeEffect.MakeForShader(sksl)
+            noise = effect.evaluate(256, 256, {'scale': 4.},
+                colorType=skia.ColorType.kRGBA_F32_ColorType)
+
+        :param int width: output width
+        :param int height: output height
+        :param uniforms: :py:class:`RuntimeEffectUniformBuffer`, dict by
+            uniform name, :py:class:`Data`, or None for no uniforms
+        :param children: list of child shaders, color filters or blenders
+        :param skia.ColorType colorType: output color type
+        :param skia.AlphaType alphaType: output alpha type
+        :param skia.Matrix localMatrix: optional matrix applied to coordinates
+        :param numpy.ndarray out: optional C-contiguous array of shape
+            (height, width, ...) to write into
+        :param int threads: number of threads; 0 uses all cores
+        :return: out, or a new array
+        )docstring",
+        py::arg("width"), py::arg("height"), py::arg("uniforms") = py::none(),
+        py::arg("children") = std::vector<SkRuntimeEffect::ChildPtr>(),
+        py::arg_v("colorType", kRGBA_8888_SkColorType,
+            "skia.ColorType.kRGBA_8888_ColorType"),
+        py::arg_v("alphaType", kPremul_SkAlphaType,
+            "skia.AlphaType.kPremul_AlphaType"),
+        py::arg("localMatrix") = nullptr, py::arg("out") = py::none(),
+        py::arg("threads") = 0)
+    .def("makeUniformBuffer",
+        [] (sk_sp<SkRuntimeEffect> runtime_effect) {
+            return UniformBuffer(runtime_effect);
+        })
+    ;
+
+uniform_buffer
+    .def(py::init(
+        [] (sk_sp<SkRuntimeEffect> effect, py::object values) {
+            CHECK_NOTNULL(effect);
+            UniformBuffer buffer(effect);
+            if (!values.is_none())
+                buffer.update(values.cast<py::dict>());
+            return buffer;
+        }),
+        R"docstring(
+        Creates a zero-filled uniform buffer for effect.
+
+        :param skia.RuntimeEffect effect: effect the uniforms belong to
+        :param dict values: optional initial values by uniform name
+        )docstring",
+        py::arg("effect"), py::arg("values") = py::none())
+    .def("index", &UniformBuffer::indexOf,
+        R"docstring(
+        Returns the index of the uniform named name, for use with
+        :py:meth:`set` and item assignment.
+
+        :raises KeyError: if the effect has no such uniform
+        )docstring",
+        py::arg("name"))
+    .def("set", &UniformBuffer::set,
+        R"docstring(
+        Writes value into the uniform at index.
+
+        value may be a scalar, a sequence, a :py:class:`V2`,
+        :py:class:`V3`, :py:class:`V4`, or a NumPy array with as many elements
+        as the uniform holds. Float uniforms are stored as float32 and int
+        uniforms as int32.
+        )docstring",
+        py::arg("index"), py::arg("value"))
+    .def("update", &UniformBuffer::update,
+        R"docstring(
+        Writes each value of the dict into the uniform of the same name.
+        )docstring",
+        py::arg("values"))
+    .def("__setitem__", &UniformBuffer::set)
+    .def("__setitem__",
+        [] (UniformBuffer& self, std::string_view name, py::handle value) {
+            self.set(self.indexOf(name), value);
+        })
+    .def("__getitem__", &UniformBuffer::get)
+    .def("__getitem__",
+        [] (const UniformBuffer& self, std::string_view name) {
+            return self.get(self.indexOf(name));
+        })
+    .def("__len__", &UniformBuffer::size)
+    .def("effect", &UniformBuffer::effect)
+    .def("data", &UniformBuffer::data,
+        R"docstring(
+        Returns the packed uniform bytes as :py:class:`Data`.
+
+        The returned data is a snapshot; later writes to the buffer do not
+        change it.
+        )docstring")
     ;
 
 py::class_<SkRuntimeEffectBuilder::BuilderUniform>(m, "RuntimeEffectBuilderUniform")
@@ -385,4 +888,5 @@ runtime_effect_builder
 m.attr("RuntimeShaderBuilder") = m.attr("RuntimeEffectBuilder");
 m.attr("RuntimeColorFilterBuilder") = m.attr("RuntimeEffectBuilder");
 m.attr("RuntimeBlendBuilder") = m.attr("RuntimeEffectBuilder");
+m.attr("UniformBuffer") = m.attr("RuntimeEffectUniformBuffer");
 }
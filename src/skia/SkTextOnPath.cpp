@@ -5,17 +5,19 @@
  * found in the LICENSE file.
  */
 
-#include "include/core/SkPathMeasure.h"
+#include "include/core/SkContourMeasure.h"
 #include "include/core/SkCanvas.h"
 #include "include/core/SkFont.h"
 #include "include/core/SkMatrix.h"
 #include "include/core/SkPath.h"
 #include "include/core/SkPaint.h"
+#include "include/core/SkRSXform.h"
+#include "include/core/SkTextBlob.h"
 
 #include "SkTextOnPath.h"
 
 static void morphpoints(SkPoint dst[], const SkPoint src[], int count,
-                        SkPathMeasure& meas, const SkMatrix& matrix) {
+                        const SkContourMeasure& meas, const SkMatrix& matrix) {
     for (int i = 0; i < count; i++) {
         SkPoint pos;
         SkVector tangent;
@@ -49,7 +51,7 @@ static void morphpoints(SkPoint dst[], const SkPoint src[], int count,
  determine that, but we need it. I guess a cheap answer is let the caller tell us,
  but that seems like a cop-out. Another answer is to get Rob Johnson to figure it out.
  */
-static void morphpath(SkPath* dst, const SkPath& src, SkPathMeasure& meas,
+static void morphpath(SkPath* dst, const SkPath& src, const SkContourMeasure& meas,
                       const SkMatrix& matrix) {
     SkPath::Iter    iter(src, false);
     SkPoint         srcP[4], dstP[3];
@@ -106,7 +108,9 @@ void SkVisitTextOnPath(const void* text, size_t byteLength, const SkPaint& paint
     font.getWidths(glyphs.data(), glyphCount, advances.data());
 
     // Prepare path measuring
-    SkPathMeasure       meas(follow, false);
+    SkContourMeasureIter measIter(follow, false);
+    sk_sp<SkContourMeasure> meas = measIter.next();
+    if (!meas) return;
     SkScalar            hOffset = 0;
 
     SkPath          iterPath;
@@ -116,7 +120,7 @@ void SkVisitTextOnPath(const void* text, size_t byteLength, const SkPaint& paint
 
     scaledMatrix.setScale(scale, scale);
 
-    SkScalar pathLength = meas.getLength();
+    SkScalar pathLength = meas->length();
     for (int i = 0; i < glyphCount; ++i) {
         if (xpos > pathLength)
             break;
@@ -130,7 +134,7 @@ void SkVisitTextOnPath(const void* text, size_t byteLength, const SkPaint& paint
             if (matrix) {
                 m.postConcat(*matrix);
             }
-            morphpath(&tmp, iterPath, meas, m);
+            morphpath(&tmp, iterPath, *meas, m);
             visitor(tmp);
         }
         xpos += advances[i];
@@ -149,3 +153,105 @@ void SkDrawTextOnPathHV(const void* text, size_t byteLength, const SkPaint& pain
     SkMatrix matrix = SkMatrix::Translate(h, v);
     SkDrawTextOnPath(text, byteLength, paint, font, follow, &matrix, canvas);
 }
+
+const SkContourMeasure* SkTextOnPathBatch::measure(const SkPath& follow) {
+    // Copies of a path share the generation ID, so labels that reuse the same
+    // road geometry are measured once.
+    uint32_t key = follow.getGenerationID();
+    auto it = fMeasures.find(key);
+    if (it == fMeasures.end()) {
+        SkContourMeasureIter measIter(follow, false);
+        it = fMeasures.emplace(key, measIter.next()).first;
+    }
+    return it->second.get();
+}
+
+const SkPath* SkTextOnPathBatch::glyphPath(SkGlyphID glyph) {
+    auto it = fGlyphPaths.find(glyph);
+    if (it == fGlyphPaths.end()) {
+        SkPath path;
+        std::optional<SkPath> entry;
+        if (fFont.getPath(glyph, &path)) {
+            entry = std::move(path);
+        }
+        it = fGlyphPaths.emplace(glyph, std::move(entry)).first;
+    }
+    return it->second ? &*it->second : nullptr;
+}
+
+int SkTextOnPathBatch::toGlyphs(const void* text, size_t byteLength) {
+    if (byteLength == 0) {
+        return 0;
+    }
+    int glyphCount = fFont.countText(text, byteLength, SkTextEncoding::kUTF8);
+    if (glyphCount <= 0) return 0;
+    fGlyphs.resize(glyphCount);
+    fFont.textToGlyphs(text, byteLength, SkTextEncoding::kUTF8, fGlyphs.data(), glyphCount);
+    fAdvances.resize(glyphCount);
+    fFont.getWidths(fGlyphs.data(), glyphCount, fAdvances.data());
+    return glyphCount;
+}
+
+int SkTextOnPathBatch::appendRSXform(SkTextBlobBuilder* builder, const void* text,
+                                     size_t byteLength, const SkPath& follow,
+                                     SkScalar hOffset, SkScalar vOffset) {
+    const SkContourMeasure* meas = this->measure(follow);
+    int glyphCount = this->toGlyphs(text, byteLength);
+    if (!meas || glyphCount == 0) return 0;
+
+    // Count the glyphs whose center still lands on the path.
+    SkScalar pathLength = meas->length();
+    int placed = 0;
+    SkScalar xpos = hOffset;
+    for (; placed < glyphCount; ++placed) {
+        if (xpos + fAdvances[placed] * 0.5f > pathLength)
+            break;
+        xpos += fAdvances[placed];
+    }
+    if (placed == 0) return 0;
+
+    const auto& run = builder->allocRunRSXform(fFont, placed);
+    SkRSXform* xforms = reinterpret_cast<SkRSXform*>(run.pos);
+    xpos = hOffset;
+    for (int i = 0; i < placed; ++i) {
+        SkScalar halfWidth = fAdvances[i] * 0.5f;
+        SkPoint pos;
+        SkVector tangent;
+        if (!meas->getPosTan(xpos + halfWidth, &pos, &tangent)) {
+            tangent.set(1, 0);
+        }
+        // Rotate the glyph about its center on the baseline, then push it
+        // along the normal by vOffset, as morphpoints() does for outlines.
+        xforms[i] = SkRSXform::Make(
+            tangent.fX, tangent.fY,
+            pos.fX - tangent.fX * halfWidth - tangent.fY * vOffset,
+            pos.fY - tangent.fY * halfWidth + tangent.fX * vOffset);
+        run.glyphs[i] = fGlyphs[i];
+        xpos += fAdvances[i];
+    }
+    return placed;
+}
+
+void SkTextOnPathBatch::visitPaths(const void* text, size_t byteLength, const SkPath& follow,
+                                   SkScalar hOffset, SkScalar vOffset,
+                                   const std::function<void(const SkPath&)>& visitor) {
+    const SkContourMeasure* meas = this->measure(follow);
+    int glyphCount = this->toGlyphs(text, byteLength);
+    if (!meas || glyphCount == 0) return;
+
+    SkScalar pathLength = meas->length();
+    SkScalar xpos = 0;
+    for (int i = 0; i < glyphCount; ++i) {
+        if (xpos + hOffset > pathLength)
+            break;
+
+        if (const SkPath* glyph = this->glyphPath(fGlyphs[i])) {
+            SkPath tmp;
+            tmp.setIsVolatile(true);
+            SkMatrix m = SkMatrix::Translate(xpos + hOffset, vOffset);
+            morphpath(&tmp, *glyph, *meas, m);
+            visitor(tmp);
+        }
+        xpos += fAdvances[i];
+    }
+}
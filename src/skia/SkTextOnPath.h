@@ -8,12 +8,21 @@
 #ifndef SkTextOnPath_DEFINED
 #define SkTextOnPath_DEFINED
 #include <functional>
+#include <optional>
+#include <unordered_map>
+#include <vector>
 
+#include "include/core/SkContourMeasure.h"
+#include "include/core/SkFont.h"
+#include "include/core/SkPath.h"
+#include "include/core/SkRefCnt.h"
 #include "include/core/SkTypes.h"
 
 class SkCanvas;
 class SkMatrix;
-class SkPath;
+class SkPaint;
+class SkTextBlob;
+class SkTextBlobBuilder;
 
 void SkVisitTextOnPath(const void* text, size_t byteLength, const SkPaint& paint, const SkFont& font,
                        const SkPath& follow, const SkMatrix* matrix,
@@ -25,5 +34,42 @@ void SkDrawTextOnPath(const void* text, size_t byteLength, const SkPaint& paint,
 void SkDrawTextOnPathHV(const void* text, size_t byteLength, const SkPaint& paint, const SkFont& font,
                         const SkPath& follow, SkScalar hOffset, SkScalar vOffset, SkCanvas* canvas);
 
+/**
+ *  Lays out many strings along many paths with a single font.
+ *
+ *  The first contour of every follow path is measured once and the glyph
+ *  outlines are fetched once, so labeling the same paths or reusing the same
+ *  glyphs repeatedly does not pay for measuring or outline extraction again.
+ *
+ *  appendRSXform() places each glyph rigidly at the path tangent of its
+ *  center, which keeps glyphs as text (cached masks, LCD, hinting). The
+ *  visitPaths() variant bends the glyph outlines along the path, matching
+ *  SkDrawTextOnPath(), for fonts and sizes where the bending is visible.
+ */
+class SkTextOnPathBatch {
+public:
+    explicit SkTextOnPathBatch(const SkFont& font) : fFont(font) {}
+
+    // Appends one RSXform run to builder. Returns the number of glyphs placed;
+    // glyphs past the end of the path are dropped.
+    int appendRSXform(SkTextBlobBuilder* builder, const void* text, size_t byteLength,
+                      const SkPath& follow, SkScalar hOffset, SkScalar vOffset);
+
+    void visitPaths(const void* text, size_t byteLength, const SkPath& follow,
+                    SkScalar hOffset, SkScalar vOffset,
+                    const std::function<void(const SkPath&)>& visitor);
+
+private:
+    const SkContourMeasure* measure(const SkPath& follow);
+    const SkPath* glyphPath(SkGlyphID glyph);
+    int toGlyphs(const void* text, size_t byteLength);
+
+    SkFont fFont;
+    std::unordered_map<uint32_t, sk_sp<SkContourMeasure>> fMeasures;
+    std::unordered_map<SkGlyphID, std::optional<SkPath>> fGlyphPaths;
+    std::vector<SkGlyphID> fGlyphs;
+    std::vector<SkScalar> fAdvances;
+};
+
 #endif
 
@@ -6,8 +6,17 @@
 #include <include/gpu/ganesh/GrTypes.h>
 #include <include/gpu/ganesh/SkSurfaceGanesh.h>
 #include <include/gpu/MutableTextureState.h>
+#include <include/effects/SkColorMatrix.h>
 #include <pybind11/operators.h>
 #include <pybind11/numpy.h>
+#include <algorithm>
+#include <deque>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <vector>
 
 namespace {
 
@@ -21,6 +30,250 @@ void PyReadPixelsCallback (
     callback(result.get());
 }
 
+uint8_t* YUVPlaneToWrite(
+    py::array array, int width, int height, size_t* rowBytes, const char* name) {
+    if (!py::isinstance<py::array_t<uint8_t>>(array))
+        throw py::type_error(std::string(name) + " must be a uint8 array.");
+    if (array.ndim() != 2 || array.shape(0) != height ||
+        array.shape(1) != width)
+        throw py::value_error(py::str(
+            "{} must have shape ({}, {}).").format(name, height, width));
+    if (array.strides(1) != 1 || array.strides(0) < width)
+        throw py::value_error(
+            std::string(name) + " must be contiguous along rows.");
+    *rowBytes = array.strides(0);
+    return static_cast<uint8_t*>(array.mutable_data());
+}
+
+inline uint8_t ToUnorm8(float value) {
+    return static_cast<uint8_t>(std::clamp(value, 0.f, 1.f) * 255.f + .5f);
+}
+
+void SurfaceReadYUV420(
+    SkSurface& surface, py::array y, py::array u, py::array v,
+    SkYUVColorSpace yuvColorSpace, int srcX, int srcY, int threads) {
+    if (y.ndim() != 2)
+        throw py::value_error("y must be a 2-dimensional array.");
+    int height = y.shape(0), width = y.shape(1);
+    int chromaWidth = (width + 1) / 2, chromaHeight = (height + 1) / 2;
+    size_t rowBytes[3];
+    uint8_t* planes[3] = {
+        YUVPlaneToWrite(y, width, height, &rowBytes[0], "y"),
+        YUVPlaneToWrite(u, chromaWidth, chromaHeight, &rowBytes[1], "u"),
+        YUVPlaneToWrite(v, chromaWidth, chromaHeight, &rowBytes[2], "v"),
+    };
+    auto bounds = SkIRect::MakeXYWH(srcX, srcY, width, height);
+    if (bounds.isEmpty() || !SkIRect::MakeSize(surface.imageInfo().dimensions())
+            .contains(bounds))
+        throw py::value_error("Planes must lie within the surface.");
+
+    // Read 8-bit raster pixels in place; anything else goes through RGBA.
+    SkPixmap pixels, src;
+    SkBitmap bitmap;
+    if (!surface.peekPixels(&pixels) ||
+        (pixels.colorType() != kRGBA_8888_SkColorType &&
+         pixels.colorType() != kBGRA_8888_SkColorType) ||
+        !pixels.extractSubset(&src, bounds)) {
+        if (!bitmap.tryAllocPixels(SkImageInfo::Make(
+                width, height, kRGBA_8888_SkColorType, kPremul_SkAlphaType,
+                surface.imageInfo().refColorSpace())) ||
+            !surface.readPixels(bitmap, srcX, srcY))
+            throw std::runtime_error("Failed to read pixels.");
+        src = bitmap.pixmap();
+    }
+
+    float m[20];
+    SkColorMatrix::RGBtoYUV(yuvColorSpace).getRowMajor(m);
+    bool bgra = src.colorType() == kBGRA_8888_SkColorType;
+    int r = bgra ? 2 : 0, b = bgra ? 0 : 2;
+    auto convert = [&] (int channel, float R, float G, float B) {
+        const float* row = m + channel * 5;
+        return ToUnorm8(row[0] * R + row[1] * G + row[2] * B + row[3] + row[4]);
+    };
+
+    // Each band covers whole chroma rows, that is two luma rows apiece.
+    py::gil_scoped_release release;
+    ParallelForBands(chromaHeight, threads, 32, [&] (int top, int bottom) {
+        std::vector<float> sums(3 * chromaWidth);
+        std::vector<int> counts(chromaWidth);
+        for (int cy = top; cy < bottom; ++cy) {
+            std::fill(sums.begin(), sums.end(), 0.f);
+            std::fill(counts.begin(), counts.end(), 0);
+            for (int row = 2 * cy; row < std::min(height, 2 * cy + 2); ++row) {
+                auto in = static_cast<const uint8_t*>(src.addr(0, row));
+                auto Y = planes[0] + row * rowBytes[0];
+                for (int x = 0; x < width; ++x) {
+                    float R = in[4 * x + r] / 255.f;
+                    float G = in[4 * x + 1] / 255.f;
+                    float B = in[4 * x + b] / 255.f;
+                    Y[x] = convert(0, R, G, B);
+                    sums[3 * (x / 2)] += R;
+                    sums[3 * (x / 2) + 1] += G;
+                    sums[3 * (x / 2) + 2] += B;
+                    ++counts[x / 2];
+                }
+            }
+            auto U = planes[1] + cy * rowBytes[1];
+            auto V = planes[2] + cy * rowBytes[2];
+            for (int x = 0; x < chromaWidth; ++x) {
+                float scale = 1.f / counts[x];
+                float R = sums[3 * x] * scale;
+                float G = sums[3 * x + 1] * scale;
+                float B = sums[3 * x + 2] * scale;
+                U[x] = convert(1, R, G, B);
+                V[x] = convert(2, R, G, B);
+            }
+        }
+    });
+}
+
+// Free list of raster surfaces by ImageInfo, bounded in bytes. Surfaces are
+// evicted least recently released first. Shared with leases, so a lease may
+// outlive its pool.
+class SurfacePool {
+public:
+    using Key = std::tuple<int, int, int, int, uint32_t>;
+
+    explicit SurfacePool(size_t maxBytes) : fMaxBytes(maxBytes) {}
+
+    sk_sp<SkSurface> acquire(const SkImageInfo& info) {
+        sk_sp<SkSurface> surface;
+        sk_sp<SkSurface> stale;  // Freed after unlocking.
+        {
+            std::lock_guard<std::mutex> lock(fMutex);
+            auto it = fFree.find(KeyOf(info));
+            if (it != fFree.end() && !it->second.empty()) {
+                auto entry = it->second.back();
+                it->second.pop_back();
+                fRetainedBytes -= entry->bytes;
+                surface = std::move(entry->surface);
+                fLRU.erase(entry);
+            }
+            if (surface && SkColorSpace::Equals(
+                    surface->imageInfo().colorSpace(), info.colorSpace()))
+                ++fHits;
+            else {
+                stale = std::move(surface);
+                ++fMisses;
+            }
+        }
+        stale.reset();
+        if (surface) {
+            surface->getCanvas()->clear(SK_ColorTRANSPARENT);
+            return surface;
+        }
+        surface = SkSurfaces::Raster(info);
+        if (!surface)
+            throw std::runtime_error("Failed to create a raster surface.");
+        return surface;
+    }
+
+    // Surfaces left with a clip are dropped, as the base clip cannot be
+    // reset.
+    void release(sk_sp<SkSurface> surface) {
+        auto canvas = surface->getCanvas();
+        canvas->restoreToCount(1);
+        canvas->resetMatrix();
+        if (!canvas->isClipRect() ||
+            canvas->getDeviceClipBounds() != surface->imageInfo().bounds())
+            return;
+        size_t bytes = surface->imageInfo().computeMinByteSize();
+        std::vector<sk_sp<SkSurface>> evicted;
+        std::lock_guard<std::mutex> lock(fMutex);
+        if (bytes > fMaxBytes)
+            return;
+        trim(fMaxBytes - bytes, &evicted);
+        auto key = KeyOf(surface->imageInfo());
+        fLRU.push_front({ key, std::move(surface), bytes });
+        fFree[key].push_back(fLRU.begin());
+        fRetainedBytes += bytes;
+    }
+
+    void purge() {
+        std::list<Entry> entries;
+        std::lock_guard<std::mutex> lock(fMutex);
+        entries.swap(fLRU);
+        fFree.clear();
+        fRetainedBytes = 0;
+    }
+
+    void setMaxBytes(size_t maxBytes) {
+        std::vector<sk_sp<SkSurface>> evicted;
+        std::lock_guard<std::mutex> lock(fMutex);
+        fMaxBytes = maxBytes;
+        trim(maxBytes, &evicted);
+    }
+
+    py::dict stats() {
+        std::lock_guard<std::mutex> lock(fMutex);
+        return py::dict(
+            py::arg("hits") = fHits,
+            py::arg("misses") = fMisses,
+            py::arg("evictions") = fEvictions,
+            py::arg("count") = fLRU.size(),
+            py::arg("bytes") = fRetainedBytes,
+            py::arg("maxBytes") = fMaxBytes);
+    }
+
+private:
+    struct Entry {
+        Key key;
+        sk_sp<SkSurface> surface;
+        size_t bytes;
+    };
+
+    // Evicts surfaces until at most `bytes` are retained. Evicted surfaces
+    // are freed by the caller after unlocking.
+    void trim(size_t bytes, std::vector<sk_sp<SkSurface>>* evicted) {
+        while (fRetainedBytes > bytes) {
+            auto& entry = fLRU.back();
+            fFree[entry.key].pop_front();
+            fRetainedBytes -= entry.bytes;
+            evicted->push_back(std::move(entry.surface));
+            fLRU.pop_back();
+            ++fEvictions;
+        }
+    }
+
+    static Key KeyOf(const SkImageInfo& info) {
+        return { info.width(), info.height(), info.colorType(),
+                 info.alphaType(),
+                 info.colorSpace() ? info.colorSpace()->hash() : 0 };
+    }
+
+    std::mutex fMutex;
+    size_t fMaxBytes;
+    size_t fRetainedBytes = 0;
+    size_t fHits = 0;
+    size_t fMisses = 0;
+    size_t fEvictions = 0;
+    std::list<Entry> fLRU;  // Most recently released first.
+    std::map<Key, std::deque<std::list<Entry>::iterator>> fFree;
+};
+
+// A surface acquired from a pool; released back by release() or on
+// context-manager exit, but not when garbage collected.
+class SurfaceLease {
+public:
+    SurfaceLease(std::shared_ptr<SurfacePool> pool, sk_sp<SkSurface> surface)
+        : fPool(std::move(pool)), fSurface(std::move(surface)) {}
+
+    sk_sp<SkSurface> surface() const {
+        if (!fSurface)
+            throw std::runtime_error("The surface is already released.");
+        return fSurface;
+    }
+
+    void release() {
+        if (fSurface)
+            fPool->release(std::move(fSurface));
+    }
+
+private:
+    std::shared_ptr<SurfacePool> fPool;
+    sk_sp<SkSurface> fSurface;
+};
+
 }  // namespace
 
 
@@ -613,6 +866,41 @@ surface
         :return: true if pixels were copied
         )docstring",
         py::arg("dst"), py::arg("srcX"), py::arg("srcY"))
+    .def("readYUV420", &SurfaceReadYUV420,
+        R"docstring(
+        Converts pixels to 8-bit Y, U and V planes with 4:2:0 chroma
+        subsampling, writing directly into the given arrays.
+
+        The read region starts at (srcX, srcY) and has the size of y; it must
+        lie within the surface. Each U and V sample is the average of the
+        2x2 pixels it covers. Alpha is ignored, and premultiplied colors are
+        converted as stored, so draw opaque content.
+
+        Raster surfaces in :py:attr:`ColorType.kRGBA_8888_ColorType` or
+        :py:attr:`ColorType.kBGRA_8888_ColorType` are converted in place;
+        other surfaces are read into a temporary RGBA buffer first.
+
+        Example::
+
+            y = np.empty((height, width), dtype=np.uint8)
+            u = np.empty(((height + 1) // 2, (width + 1) // 2), dtype=np.uint8)
+            v = np.empty_like(u)
+            surface.readYUV420(y, u, v)
+
+        :param numpy.ndarray y: writable uint8 array of shape=(height, width)
+        :param numpy.ndarray u: writable uint8 array of shape=(
+            (height + 1) // 2, (width + 1) // 2)
+        :param numpy.ndarray v: writable uint8 array of the same shape as u
+        :param skia.YUVColorSpace yuvColorSpace: how RGB values are converted
+            to YUV
+        :param int srcX: offset into surface pixels on x-axis
+        :param int srcY: offset into surface pixels on y-axis
+        :param int threads: number of threads; 0 uses all cores
+        )docstring",
+        py::arg("y"), py::arg("u"), py::arg("v"),
+        py::arg_v("yuvColorSpace", kRec709_SkYUVColorSpace,
+            "skia.YUVColorSpace.kRec709_YUVColorSpace"),
+        py::arg("srcX") = 0, py::arg("srcY") = 0, py::arg("threads") = 1)
     .def("asyncRescaleAndReadPixels",
         [] (SkSurface& surface, const SkImageInfo& info, const SkIRect& srcRect,
             SkSurface::RescaleGamma rescaleGamma,
@@ -1303,6 +1591,111 @@ surface
         py::arg("width"), py::arg("height"))
     ;
 
+py::class_<SurfacePool, std::shared_ptr<SurfacePool>> surfacepool(
+    m, "SurfacePool", R"docstring(
+    Reuses raster :py:class:`Surface` objects of the same
+    :py:class:`ImageInfo` instead of allocating pixel memory for each render.
+
+    :py:meth:`acquire` returns a :py:class:`SurfacePool.Lease`. Used as a
+    context manager, the lease gives a cleared surface and returns it to the
+    pool on exit. Do not keep using the surface after that. Surfaces that are
+    not returned are simply freed.
+
+    Returned surfaces are kept up to ``maxBytes`` of pixel memory, dropping
+    the least recently returned ones first. The pool is thread-safe.
+
+    Example::
+
+        pool = skia.SurfacePool(maxBytes=64 * 1024 * 1024)
+        for tile in tiles:
+            with pool.acquire(256, 256) as surface:
+                surface.getCanvas().drawPicture(tile)
+                array = surface.toarray()
+        print(pool.stats())
+    )docstring");
+
+py::class_<SurfaceLease>(surfacepool, "Lease", R"docstring(
+    A :py:class:`Surface` acquired from :py:class:`SurfacePool`.
+    )docstring")
+    .def("surface", &SurfaceLease::surface,
+        R"docstring(
+        Returns the leased surface.
+        )docstring")
+    .def("release", &SurfaceLease::release,
+        R"docstring(
+        Returns the surface to the pool. Later calls do nothing.
+
+        Surfaces with a clip on their base layer, which cannot be reset, are
+        freed instead.
+        )docstring")
+    .def("__enter__", &SurfaceLease::surface)
+    .def("__exit__",
+        [] (SurfaceLease& lease, py::object exc_type, py::object exc_value,
+            py::object traceback) { lease.release(); })
+    ;
+
+surfacepool
+    .def(py::init<size_t>(),
+        R"docstring(
+        Creates an empty pool.
+
+        :param int maxBytes: pixel memory to keep in returned surfaces
+        )docstring",
+        py::arg("maxBytes") = size_t(64) << 20)
+    .def("acquire",
+        [] (std::shared_ptr<SurfacePool> pool, const SkImageInfo& info) {
+            sk_sp<SkSurface> surface;
+            {
+                py::gil_scoped_release release;
+                surface = pool->acquire(info);
+            }
+            return SurfaceLease(pool, surface);
+        },
+        R"docstring(
+        Leases a raster surface of ``info``, cleared to transparent black.
+
+        :param skia.ImageInfo info: width, height, color type, alpha type and
+            color space of the surface
+        :rtype: skia.SurfacePool.Lease
+        )docstring",
+        py::arg("info"))
+    .def("acquire",
+        [] (std::shared_ptr<SurfacePool> pool, int width, int height) {
+            sk_sp<SkSurface> surface;
+            {
+                py::gil_scoped_release release;
+                surface = pool->acquire(
+                    SkImageInfo::MakeN32Premul(width, height));
+            }
+            return SurfaceLease(pool, surface);
+        },
+        R"docstring(
+        Leases an N32 premultiplied raster surface, cleared to transparent
+        black.
+
+        :param int width: pixel column count; must be greater than zero
+        :param int height: pixel row count; must be greater than zero
+        :rtype: skia.SurfacePool.Lease
+        )docstring",
+        py::arg("width"), py::arg("height"))
+    .def("stats", &SurfacePool::stats,
+        R"docstring(
+        Returns a dict of pool statistics: ``hits`` and ``misses`` of
+        :py:meth:`acquire`, ``evictions``, the ``count`` and ``bytes`` of
+        surfaces kept, and ``maxBytes``.
+        )docstring")
+    .def("purge", &SurfacePool::purge,
+        R"docstring(
+        Frees every surface kept in the pool.
+        )docstring")
+    .def("setMaxBytes", &SurfacePool::setMaxBytes,
+        R"docstring(
+        Sets the pixel memory to keep, freeing the least recently returned
+        surfaces above the new limit.
+        )docstring",
+        py::arg("maxBytes"))
+    ;
+
 // Surfaces is a namespace
 m.attr("Surfaces") = m.attr("Surface");
 m.attr("Surface").attr("Raster") = m.attr("Surface").attr("MakeRaster");
@@ -2,12 +2,82 @@
 #include <include/core/SkSerialProcs.h>
 #include <include/core/SkRSXform.h>
 #include <modules/skshaper/include/SkShaper.h>
+#include <pybind11/numpy.h>
 #include <pybind11/stl.h>
 #include <float.h> // FLT_MAX
+#include <cstring>
+
+#include "SkTextOnPath.h"
 
 template<>
 struct py::detail::has_operator_delete<SkTextBlob, void> : std::false_type {};
 
+typedef py::array_t<SkGlyphID, py::array::c_style | py::array::forcecast>
+    GlyphArray;
+typedef py::array_t<SkScalar, py::array::c_style | py::array::forcecast>
+    ScalarArray;
+typedef py::array_t<int64_t, py::array::c_style | py::array::forcecast>
+    OffsetArray;
+
+namespace {
+
+sk_sp<SkTextBlob> TextBlob_MakeFromArrays(
+    const SkFont& font, GlyphArray glyphs, ScalarArray positions,
+    py::object runOffsets) {
+    if (glyphs.ndim() != 1)
+        throw py::value_error(py::str(
+            "glyphs must be 1-dimensional (given {} dimensions).").format(
+            glyphs.ndim()));
+    py::ssize_t count = glyphs.shape(0);
+    if (positions.ndim() != 2 || positions.shape(0) != count ||
+        (positions.shape(1) != 2 && positions.shape(1) != 4))
+        throw py::value_error(py::str(
+            "positions must have shape ({}, 2) or ({}, 4).").format(
+            count, count));
+    bool rsxform = positions.shape(1) == 4;
+
+    std::vector<int64_t> offsets;
+    if (runOffsets.is_none()) {
+        offsets.push_back(0);
+    } else {
+        auto array = OffsetArray::ensure(runOffsets);
+        if (!array || array.ndim() != 1)
+            throw py::value_error("run_offsets must be a 1-dimensional array.");
+        offsets.assign(array.data(), array.data() + array.size());
+    }
+    if (offsets.empty() || offsets.front() != 0)
+        throw py::value_error("run_offsets must start with 0.");
+    if (offsets.back() != count)
+        offsets.push_back(count);
+    for (size_t i = 1; i < offsets.size(); ++i) {
+        if (offsets[i] < offsets[i - 1] || offsets[i] > count)
+            throw py::value_error(py::str(
+                "run_offsets must be non-decreasing and at most {}.").format(
+                count));
+    }
+
+    const SkGlyphID* glyphData = glyphs.data();
+    const SkScalar* posData = positions.data();
+    size_t stride = rsxform ? 4 : 2;
+    SkTextBlobBuilder builder;
+    for (size_t i = 1; i < offsets.size(); ++i) {
+        int64_t start = offsets[i - 1];
+        int runCount = static_cast<int>(offsets[i] - start);
+        if (runCount == 0)
+            continue;
+        const auto& run = (rsxform) ?
+            builder.allocRunRSXform(font, runCount) :
+            builder.allocRunPos(font, runCount);
+        std::memcpy(run.glyphs, glyphData + start,
+                    runCount * sizeof(SkGlyphID));
+        std::memcpy(run.pos, posData + start * stride,
+                    runCount * stride * sizeof(SkScalar));
+    }
+    return builder.make();
+}
+
+}  // namespace
+
 void initTextBlob(py::module &m) {
 py::class_<SkTextBlob, sk_sp<SkTextBlob>> textblob(m, "TextBlob", R"docstring(
     :py:class:`TextBlob` combines multiple text runs into an immutable
@@ -348,6 +418,62 @@ textblob
         },
         py::arg("text"), py::arg("xform"), py::arg("font"),
         py::arg_v("encoding", SkTextEncoding::kUTF8, "skia.TextEncoding.kUTF8"))
+    .def_static("MakeFromArrays", &TextBlob_MakeFromArrays,
+        R"docstring(
+        Returns a textblob built from glyph and position arrays, without
+        creating per-glyph Python objects.
+
+        Positions of shape (N, 2) are (x, y) points, as in
+        :py:meth:`TextBlobBuilder.allocRunPos`. Positions of shape (N, 4) are
+        (scos, ssin, tx, ty) :py:class:`RSXform` values, as in
+        :py:meth:`TextBlobBuilder.allocRunRSXform`. The arrays are copied into
+        the run buffers as-is; other dtypes are converted to uint16 and float32
+        first.
+
+        run_offsets splits the glyphs into runs. It holds the start index of
+        each run and must begin with 0; a trailing N is allowed. Runs share
+        font.
+
+        Example::
+
+            glyphs = np.array([36, 37, 38, 39], dtype=np.uint16)
+            positions = np.array(
+                [[0, 10], [8, 10], [0, 30], [8, 30]], dtype=np.float32)
+            blob = skia.TextBlob.MakeFromArrays(font, glyphs, positions, [0, 2])
+
+        :param skia.Font font: :py:class:`Font` used for all runs
+        :param numpy.ndarray glyphs: uint16 array of N glyph IDs
+        :param numpy.ndarray positions: float32 array of shape (N, 2) or (N, 4)
+        :param run_offsets: start index of each run; one run if None
+        :return: new textblob or None if there are no glyphs
+        )docstring",
+        py::arg("font"), py::arg("glyphs"), py::arg("positions"),
+        py::arg("run_offsets") = py::none())
+    .def_static("MakeOnPath",
+        [] (const std::string& text, const SkPath& path, const SkFont& font,
+            SkScalar hOffset, SkScalar vOffset) {
+            SkTextOnPathBatch batch(font);
+            SkTextBlobBuilder builder;
+            batch.appendRSXform(
+                &builder, text.c_str(), text.size(), path, hOffset, vOffset);
+            return builder.make();
+        },
+        R"docstring(
+        Returns a textblob with a single :py:class:`RSXform` run that places
+        UTF-8 text along the first contour of path.
+
+        Each glyph is rotated to the path tangent at its center. Glyphs whose
+        center falls past the end of the path are dropped.
+
+        :param str text: character code points drawn
+        :param skia.Path path: path to follow
+        :param skia.Font font: :py:class:`Font` used for this run
+        :param float hOffset: distance along the path to the first glyph
+        :param float vOffset: distance along the path normal
+        :return: new textblob or None if no glyph fits on the path
+        )docstring",
+        py::arg("text"), py::arg("path"), py::arg("font"),
+        py::arg("hOffset") = 0, py::arg("vOffset") = 0)
     .def_static("Deserialize",
         [] (py::buffer b) {
             auto info = b.request();
@@ -0,0 +1,318 @@
+#include "common.h"
+#include <include/utils/SkEventTracer.h>
+#include <include/utils/SkTraceEventPhase.h>
+#include <chrono>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+// Argument types of TRACE_EVENT macros, from SkTraceEventCommon.h.
+enum TraceValueType : uint8_t {
+    kBool_TraceValueType = 1,
+    kUInt_TraceValueType = 2,
+    kInt_TraceValueType = 3,
+    kDouble_TraceValueType = 4,
+    kPointer_TraceValueType = 5,
+    kString_TraceValueType = 6,
+    kCopyString_TraceValueType = 7,
+};
+
+void WriteJSONString(std::ostream& out, const char* s) {
+    out << '"';
+    for (; s && *s; ++s) {
+        unsigned char c = *s;
+        if (c == '"' || c == '\\')
+            out << '\\' << c;
+        else if (c < 0x20) {
+            char buffer[8];
+            snprintf(buffer, sizeof(buffer), "\\u%04x", c);
+            out << buffer;
+        } else
+            out << c;
+    }
+    out << '"';
+}
+
+// Keeps events in memory between start() and stop(), and writes them as Chrome
+// trace JSON. Installed once, as Skia allows only one tracer per process;
+// stop() disables every category so macros skip the tracer altogether.
+class ChromeTraceEventTracer : public SkEventTracer {
+public:
+    static ChromeTraceEventTracer* Get() {
+        static ChromeTraceEventTracer* tracer = [] {
+            auto tracer = new ChromeTraceEventTracer();
+            if (!SkEventTracer::SetInstance(tracer, /*leakTracer=*/true))
+                return static_cast<ChromeTraceEventTracer*>(nullptr);
+            return tracer;
+        }();
+        if (!tracer)
+            throw std::runtime_error("Another event tracer is installed.");
+        return tracer;
+    }
+
+    void start(const std::vector<std::string>& patterns) {
+        std::lock_guard<std::mutex> lock(fMutex);
+        if (fRecording)
+            throw std::runtime_error("Tracing has already started.");
+        fPatterns = patterns;
+        fRecording = true;
+        fEvents.clear();
+        fStart = std::chrono::steady_clock::now();
+        ++fSession;
+        for (auto& it : fNames)
+            *const_cast<uint8_t*>(it.first) = flagsFor(it.second);
+    }
+
+    std::string stop() {
+        std::vector<Event> events;
+        std::unordered_map<const uint8_t*, std::string> names;
+        {
+            std::lock_guard<std::mutex> lock(fMutex);
+            if (!fRecording)
+                throw std::runtime_error("Tracing has not started.");
+            fRecording = false;
+            for (auto& it : fNames)
+                *const_cast<uint8_t*>(it.first) = 0;
+            events.swap(fEvents);
+            names = fNames;
+        }
+        std::ostringstream out;
+        out << "{\"traceEvents\":[";
+        for (size_t i = 0; i < events.size(); ++i) {
+            const auto& event = events[i];
+            if (i)
+                out << ',';
+            out << "{\"name\":";
+            WriteJSONString(out, event.name.c_str());
+            out << ",\"cat\":";
+            WriteJSONString(out, names[event.category].c_str());
+            out << ",\"ph\":\"" << event.phase << "\",\"ts\":" << event.timestamp;
+            if (event.phase == TRACE_EVENT_PHASE_COMPLETE)
+                out << ",\"dur\":" << event.duration;
+            out << ",\"pid\":1,\"tid\":" << event.thread;
+            if (event.id)
+                out << ",\"id\":" << event.id;
+            if (!event.args.empty())
+                out << ",\"args\":{" << event.args << '}';
+            out << '}';
+        }
+        out << "],\"displayTimeUnit\":\"ms\"}";
+        return out.str();
+    }
+
+    bool isRecording() {
+        std::lock_guard<std::mutex> lock(fMutex);
+        return fRecording;
+    }
+
+    const uint8_t* getCategoryGroupEnabled(const char* name) override {
+        std::lock_guard<std::mutex> lock(fMutex);
+        auto it = fFlags.find(name);
+        if (it != fFlags.end())
+            return it->second;
+        fFlagStorage.push_back(fRecording ? flagsFor(name) : 0);
+        const uint8_t* flag = &fFlagStorage.back();
+        fFlags[name] = flag;
+        fNames[flag] = name;
+        return flag;
+    }
+
+    const char* getCategoryGroupName(const uint8_t* categoryEnabledFlag) override {
+        std::lock_guard<std::mutex> lock(fMutex);
+        auto it = fNames.find(categoryEnabledFlag);
+        return (it != fNames.end()) ? it->second.c_str() : "";
+    }
+
+    SkEventTracer::Handle addTraceEvent(
+        char phase, const uint8_t* categoryEnabledFlag, const char* name,
+        uint64_t id, int32_t numArgs, const char** argNames,
+        const uint8_t* argTypes, const uint64_t* argValues,
+        uint8_t flags) override {
+        Event event;
+        event.phase = phase;
+        event.category = categoryEnabledFlag;
+        event.name = name ? name : "";
+        event.id = id;
+        event.thread = std::hash<std::thread::id>()(std::this_thread::get_id())
+            & 0x7fffffff;
+        if (numArgs > 0)
+            event.args = formatArgs(numArgs, argNames, argTypes, argValues);
+
+        std::lock_guard<std::mutex> lock(fMutex);
+        if (!fRecording)
+            return 0;
+        event.timestamp = microseconds();
+        fEvents.push_back(std::move(event));
+        return (fSession << 32) | fEvents.size();
+    }
+
+    void updateTraceEventDuration(
+        const uint8_t*, const char*, SkEventTracer::Handle handle) override {
+        std::lock_guard<std::mutex> lock(fMutex);
+        size_t index = handle & 0xffffffff;
+        if (!fRecording || (handle >> 32) != fSession || index == 0 ||
+            index > fEvents.size())
+            return;
+        auto& event = fEvents[index - 1];
+        event.duration = microseconds() - event.timestamp;
+    }
+
+private:
+    struct Event {
+        char phase;
+        const uint8_t* category;
+        std::string name;
+        uint64_t id = 0;
+        size_t thread = 0;
+        double timestamp = 0;
+        double duration = 0;
+        std::string args;
+    };
+
+    // Patterns match any comma-separated part of a category group, exactly or
+    // by prefix with a trailing '*'. "disabled-by-default-" categories only
+    // match patterns that start with that prefix themselves.
+    uint8_t flagsFor(const std::string& group) const {
+        static constexpr std::string_view kDisabledByDefault =
+            "disabled-by-default-";
+        std::stringstream parts(group);
+        std::string part;
+        while (std::getline(parts, part, ',')) {
+            bool disabledByDefault = part.rfind(kDisabledByDefault, 0) == 0;
+            for (auto& pattern : fPatterns) {
+                if (disabledByDefault &&
+                    pattern.rfind(kDisabledByDefault, 0) != 0)
+                    continue;
+                bool match = (!pattern.empty() && pattern.back() == '*') ?
+                    part.compare(0, pattern.size() - 1, pattern, 0,
+                                 pattern.size() - 1) == 0 :
+                    part == pattern;
+                if (match)
+                    return kEnabledForRecording_CategoryGroupEnabledFlags;
+            }
+        }
+        return 0;
+    }
+
+    double microseconds() const {
+        return std::chrono::duration<double, std::micro>(
+            std::chrono::steady_clock::now() - fStart).count();
+    }
+
+    static std::string formatArgs(int numArgs, const char** argNames,
+                                  const uint8_t* argTypes,
+                                  const uint64_t* argValues) {
+        std::ostringstream out;
+        for (int i = 0; i < numArgs; ++i) {
+            if (i)
+                out << ',';
+            WriteJSONString(out, argNames[i]);
+            out << ':';
+            switch (argTypes[i]) {
+                case kBool_TraceValueType:
+                    out << (argValues[i] ? "true" : "false");
+                    break;
+                case kUInt_TraceValueType:
+                    out << argValues[i];
+                    break;
+                case kInt_TraceValueType:
+                    out << static_cast<int64_t>(argValues[i]);
+                    break;
+                case kDouble_TraceValueType: {
+                    double value;
+                    memcpy(&value, &argValues[i], sizeof(value));
+                    out << value;
+                    break;
+                }
+                case kString_TraceValueType:
+                case kCopyString_TraceValueType:
+                    WriteJSONString(
+                        out, reinterpret_cast<const char*>(argValues[i]));
+                    break;
+                default:
+                    out << "\"0x" << std::hex << argValues[i] << std::dec
+                        << '"';
+                    break;
+            }
+        }
+        return out.str();
+    }
+
+    std::mutex fMutex;
+    bool fRecording = false;
+    uint64_t fSession = 0;
+    std::vector<std::string> fPatterns;
+    std::chrono::steady_clock::time_point fStart;
+    std::vector<Event> fEvents;
+    std::deque<uint8_t> fFlagStorage;
+    std::unordered_map<std::string, const uint8_t*> fFlags;
+    std::unordered_map<const uint8_t*, std::string> fNames;
+};
+
+}  // namespace
+
+void initTracing(py::module &m) {
+py::module tracing = m.def_submodule("tracing", R"docstring(
+    Records Skia's internal trace events, e.g., inside
+    :py:meth:`Canvas.drawPicture`, codec decoding and PDF output, as Chrome
+    trace JSON that chrome://tracing and Perfetto open.
+
+    Example::
+
+        skia.tracing.start(['skia*'])
+        canvas.drawPicture(picture)
+        with open('trace.json', 'wb') as f:
+            f.write(skia.tracing.stop())
+    )docstring");
+
+tracing.def("start",
+    [] (py::object categories) {
+        std::vector<std::string> patterns;
+        if (categories.is_none())
+            patterns.push_back("*");
+        else if (py::isinstance<py::str>(categories)) {
+            std::stringstream parts(categories.cast<std::string>());
+            std::string part;
+            while (std::getline(parts, part, ','))
+                patterns.push_back(part);
+        } else
+            patterns = categories.cast<std::vector<std::string>>();
+        ChromeTraceEventTracer::Get()->start(patterns);
+    },
+    R"docstring(
+    Starts recording trace events in memory.
+
+    :param categories: category names to record, as a list or a
+        comma-separated str. A trailing ``*`` matches by prefix. None records
+        every category except ``disabled-by-default-*`` ones, which are only
+        matched by patterns that start with ``disabled-by-default-``.
+    )docstring",
+    py::arg("categories") = py::none());
+tracing.def("stop",
+    [] {
+        std::string json;
+        {
+            py::gil_scoped_release release;
+            json = ChromeTraceEventTracer::Get()->stop();
+        }
+        return py::bytes(json);
+    },
+    R"docstring(
+    Stops recording and returns the events as Chrome trace JSON.
+
+    :return: bytes
+    )docstring");
+tracing.def("isEnabled",
+    [] { return ChromeTraceEventTracer::Get()->isRecording(); },
+    R"docstring(
+    Returns true while recording.
+    )docstring");
+}
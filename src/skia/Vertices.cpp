@@ -1,5 +1,7 @@
 #include "common.h"
+#include <pybind11/numpy.h>
 #include <pybind11/stl.h>
+#include <cstring>
 
 namespace {
 
@@ -40,6 +42,165 @@ sk_sp<SkVertices> MakeCopy(
         indices_.data());
 }
 
+using PointArray = py::array_t<float, py::array::c_style | py::array::forcecast>;
+using ColorArray = py::array_t<uint32_t, py::array::c_style | py::array::forcecast>;
+using IndexArray = py::array_t<uint32_t, py::array::c_style | py::array::forcecast>;
+
+// Indices are uint16_t, so one indexed SkVertices addresses this many vertices.
+const size_t kMaxIndexedVertices = 1 << 16;
+
+PointArray EnsurePoints(py::object object, size_t count, const char* name) {
+    auto array = PointArray::ensure(object);
+    if (!array || array.ndim() != 2 || array.shape(1) != 2 ||
+        (count && static_cast<size_t>(array.shape(0)) != count))
+        throw py::value_error(
+            py::str("{} must be a float32 array of shape (N, 2).").format(name));
+    return array;
+}
+
+// Copies the given vertices, in `order` or all of them, into a new SkVertices.
+sk_sp<SkVertices> BuildVertices(
+    SkVertices::VertexMode mode, const SkPoint* positions,
+    const SkPoint* texs, const SkColor* colors, size_t vertexCount,
+    const std::vector<uint32_t>* order, const std::vector<uint16_t>* indices) {
+    uint32_t flags = 0;
+    if (texs)
+        flags |= SkVertices::kHasTexCoords_BuilderFlag;
+    if (colors)
+        flags |= SkVertices::kHasColors_BuilderFlag;
+    SkVertices::Builder builder(
+        mode, static_cast<int>(vertexCount),
+        indices ? static_cast<int>(indices->size()) : 0, flags);
+    if (!builder.isValid())
+        throw std::runtime_error("Failed to allocate vertices.");
+    if (order) {
+        for (size_t i = 0; i < vertexCount; ++i) {
+            uint32_t v = (*order)[i];
+            builder.positions()[i] = positions[v];
+            if (texs)
+                builder.texCoords()[i] = texs[v];
+            if (colors)
+                builder.colors()[i] = colors[v];
+        }
+    } else {
+        memcpy(builder.positions(), positions, vertexCount * sizeof(SkPoint));
+        if (texs)
+            memcpy(builder.texCoords(), texs, vertexCount * sizeof(SkPoint));
+        if (colors)
+            memcpy(builder.colors(), colors, vertexCount * sizeof(SkColor));
+    }
+    if (indices)
+        memcpy(builder.indices(), indices->data(),
+               indices->size() * sizeof(uint16_t));
+    return builder.detach();
+}
+
+// Rewrites strip and fan indices as a triangle list.
+std::vector<uint32_t> ToTriangles(
+    SkVertices::VertexMode mode, const uint32_t* indices, size_t count) {
+    if (mode == SkVertices::kTriangles_VertexMode)
+        return std::vector<uint32_t>(indices, indices + count);
+    std::vector<uint32_t> triangles;
+    for (size_t i = 2; i < count; ++i) {
+        if (mode == SkVertices::kTriangleFan_VertexMode)
+            triangles.insert(triangles.end(),
+                             { indices[0], indices[i - 1], indices[i] });
+        else
+            triangles.insert(triangles.end(),
+                             { indices[i - 2], indices[i - 1], indices[i] });
+    }
+    return triangles;
+}
+
+py::list MakeFromArrays(
+    SkVertices::VertexMode mode, py::object positions, py::object texs,
+    py::object colors, py::object indices) {
+    auto positions_ = EnsurePoints(positions, 0, "positions");
+    size_t vertexCount = positions_.shape(0);
+    if (vertexCount == 0)
+        throw py::value_error("Vertex must have at least one element");
+    PointArray texs_;
+    if (!texs.is_none())
+        texs_ = EnsurePoints(texs, vertexCount, "texs");
+    ColorArray colors_;
+    if (!colors.is_none()) {
+        colors_ = ColorArray::ensure(colors);
+        if (!colors_ || colors_.size() != static_cast<py::ssize_t>(vertexCount))
+            throw py::value_error(
+                "colors must be a uint32 array of N elements.");
+    }
+    IndexArray indices_;
+    if (!indices.is_none()) {
+        indices_ = IndexArray::ensure(indices);
+        if (!indices_)
+            throw py::value_error("indices must be a uint32 array.");
+    }
+
+    auto pos = reinterpret_cast<const SkPoint*>(positions_.data());
+    auto tex = (texs.is_none()) ?
+        nullptr : reinterpret_cast<const SkPoint*>(texs_.data());
+    auto col = (colors.is_none()) ?
+        nullptr : reinterpret_cast<const SkColor*>(colors_.data());
+    const uint32_t* idx = (indices.is_none()) ? nullptr : indices_.data();
+    size_t indexCount = (indices.is_none()) ? 0 : indices_.size();
+
+    std::vector<sk_sp<SkVertices>> chunks;
+    {
+        py::gil_scoped_release release;
+        for (size_t i = 0; i < indexCount; ++i) {
+            if (idx[i] >= vertexCount)
+                throw py::index_error("indices must be less than N.");
+        }
+        if (!idx) {
+            chunks.push_back(BuildVertices(
+                mode, pos, tex, col, vertexCount, nullptr, nullptr));
+        } else if (vertexCount <= kMaxIndexedVertices) {
+            std::vector<uint16_t> indices16(idx, idx + indexCount);
+            chunks.push_back(BuildVertices(
+                mode, pos, tex, col, vertexCount, nullptr, &indices16));
+        } else {
+            // Split into triangle lists whose vertices fit uint16_t indices.
+            auto triangles = ToTriangles(mode, idx, indexCount);
+            std::vector<int> local(vertexCount, -1);
+            std::vector<uint32_t> order;
+            std::vector<uint16_t> chunkIndices;
+            auto flush = [&] {
+                if (chunkIndices.empty())
+                    return;
+                chunks.push_back(BuildVertices(
+                    SkVertices::kTriangles_VertexMode, pos, tex, col,
+                    order.size(), &order, &chunkIndices));
+                for (auto v : order)
+                    local[v] = -1;
+                order.clear();
+                chunkIndices.clear();
+            };
+            for (size_t t = 0; t + 2 < triangles.size(); t += 3) {
+                const uint32_t* triangle = &triangles[t];
+                size_t added = (local[triangle[0]] < 0) +
+                    (local[triangle[1]] < 0 && triangle[1] != triangle[0]) +
+                    (local[triangle[2]] < 0 && triangle[2] != triangle[0] &&
+                     triangle[2] != triangle[1]);
+                if (order.size() + added > kMaxIndexedVertices)
+                    flush();
+                for (int k = 0; k < 3; ++k) {
+                    uint32_t v = triangle[k];
+                    if (local[v] < 0) {
+                        local[v] = static_cast<int>(order.size());
+                        order.push_back(v);
+                    }
+                    chunkIndices.push_back(static_cast<uint16_t>(local[v]));
+                }
+            }
+            flush();
+        }
+    }
+    py::list result;
+    for (auto& chunk : chunks)
+        result.append(chunk);
+    return result;
+}
+
 }  // namespace
 
 template<>
@@ -97,5 +258,35 @@ vertices
         )docstring",
         py::arg("mode"), py::arg("positions"), py::arg("texs") = nullptr,
         py::arg("colors") = nullptr, py::arg("indices") = nullptr)
+    .def_static("MakeFromArrays", &MakeFromArrays,
+        R"docstring(
+        Create vertices by copying NumPy arrays straight into vertex storage.
+
+        Indexed meshes with more than 65536 vertices do not fit the 16-bit
+        indices of :py:class:`Vertices`, so they are split into several
+        triangle-list :py:class:`Vertices`; strips and fans are converted to
+        triangles first. The returned list can be passed as is to
+        :py:meth:`Canvas.drawVertices`.
+
+        Example::
+
+            positions = np.random.rand(300000, 2).astype(np.float32) * 512
+            indices = np.arange(300000, dtype=np.uint32)
+            chunks = skia.Vertices.MakeFromArrays(
+                skia.Vertices.kTriangles_VertexMode, positions,
+                indices=indices)
+            canvas.drawVertices(chunks, paint)
+
+        :param skia.Vertices.VertexMode mode: vertex mode
+        :param numpy.ndarray positions: float32 array of shape (N, 2)
+        :param numpy.ndarray texs: float32 array of shape (N, 2); may be None
+        :param numpy.ndarray colors: uint32 array of N ARGB colors; may be
+            None
+        :param numpy.ndarray indices: uint32 array of indices into positions;
+            may be None
+        :return: list of :py:class:`Vertices`
+        )docstring",
+        py::arg("mode"), py::arg("positions"), py::arg("texs") = nullptr,
+        py::arg("colors") = nullptr, py::arg("indices") = nullptr)
     ;
 }
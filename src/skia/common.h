@@ -28,6 +28,7 @@
 #include <include/core/SkRect.h>
 #include <include/core/SkRefCnt.h>
 #include <include/core/SkRegion.h>
+#include <include/core/SkSamplingOptions.h>
 #include <include/core/SkShader.h>
 #include <include/core/SkSize.h>
 #include <include/core/SkStream.h>
@@ -36,6 +37,7 @@
 #include <modules/svg/include/SkSVGDOM.h>
 #include <include/core/SkTextBlob.h>
 #include <include/core/SkVertices.h>
+#include <functional>
 #include <sstream>
 
 namespace pybind11 { class array; }  // namespace pybind11
@@ -98,4 +100,52 @@ py::memoryview ImageInfoToMemoryView(
     bool readonly = true);
 py::dict ImageInfoToArrayInterface(
     const SkImageInfo& imageInfo, size_t rowBytes = 0);
+
+// Runs fn(i) for every i in [0, count) on up to `threads` worker threads,
+// where 0 means the hardware concurrency. fn must not touch Python objects;
+// callers release the GIL around this call.
+void ParallelFor(int count, int threads, const std::function<void(int)>& fn);
+
+// Splits height rows into bands of about rowsPerBand rows and calls
+// fn(top, bottom) for each band through ParallelFor.
+void ParallelForBands(int height, int threads, int rowsPerBand,
+                      const std::function<void(int, int)>& fn);
+
+// Same as SkPixmap::scalePixels, but renders row bands of dst on `threads`
+// threads with the GIL released. src must not be texture backed.
+bool ScalePixelsParallel(sk_sp<const SkImage> src, const SkPixmap& dst,
+                         const SkSamplingOptions& sampling, int threads);
+
+// Converts src into dst, which must have the same dimensions, by row bands on
+// `threads` threads with the GIL released.
+bool ConvertPixelsParallel(const SkPixmap& src, const SkPixmap& dst,
+                           int threads);
+
+// Returns the color space for raw ICC profile bytes, sharing one instance per
+// distinct profile through a process-wide cache. Returns nullptr if the
+// profile cannot be parsed or has no SkColorSpace equivalent.
+sk_sp<SkColorSpace> ColorSpaceFromICC(const void* data, size_t size);
+
+// Makes a paint from attribute names, e.g., {'Color': 0xFFFF0000}, as
+// skia.Paint(**kwargs) does.
+SkPaint PaintFromDict(py::dict dict);
+
+// Re-records picture with nested pictures played inline, so the result holds
+// no references to other pictures, including Python subclasses.
+sk_sp<SkPicture> PictureFlatten(const SkPicture& picture);
+
+class SkFontMgr;
+
+// The platform font manager shared by typeface bindings.
+sk_sp<SkFontMgr> SkFontMgr_RefDefault();
+
+class SkTraceMemoryDump;
+
+// Calls dump() with an SkTraceMemoryDump that records every value, and returns
+// them as {dumpName: {valueName: value}}, or with asArrays as columns of
+// numeric values. The GIL is released only with releaseGIL; keep it when
+// dump() touches objects that are not thread-safe, e.g. GrDirectContext.
+py::dict CollectMemoryDump(
+    const std::function<void(SkTraceMemoryDump*)>& dump, bool detailed,
+    bool asArrays = false, bool releaseGIL = false);
 #endif  // _COMMON_H_
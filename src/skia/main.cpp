@@ -6,6 +6,7 @@
 #define STRING(s) #s
 
 // Declarations.
+void initArena(py::module &);
 void initBitmap(py::module &);
 void initBlendMode(py::module &);
 void initCanvas(py::module &);
@@ -13,12 +14,15 @@ void initColor(py::module &);
 void initCodec(py::module &);
 void initColorSpace(py::module &);
 void initData(py::module &);
+void initDeferredCanvas(py::module &);
 void initDocument(py::module &);
 void initGrContext(py::module &);
 void initFont(py::module &);
+void initGraphics(py::module &);
 void initImage(py::module &);
 void initImageInfo(py::module &);
 void initMatrix(py::module &);
+void initMesh(py::module &);
 void initPaint(py::module &);
 void initParagraph(py::module &);
 void initPath(py::module &);
@@ -37,6 +41,7 @@ void initStream(py::module &);
 void initString(py::module &);
 void initSurface(py::module &);
 void initTextBlob(py::module &);
+void initTracing(py::module &);
 void initUnicode(py::module &);
 void initVertices(py::module &);
 void initSVGDOM(py::module &);
@@ -67,6 +72,7 @@ PYBIND11_MODULE(skia, m) {
     initDocument(m);
     initFont(m);
     initGrContext(m);
+    initGraphics(m);
     initImageInfo(m);
     initImage(m);
     initPaint(m);
@@ -75,11 +81,15 @@ PYBIND11_MODULE(skia, m) {
     initPath(m);
     initPathMeasure(m);
     initPicture(m);
+    initDeferredCanvas(m);
     initPixmap(m);
     initRuntimeEffect(m);
+    initMesh(m); // After RuntimeEffect
     initScalar(m);
     initTextBlob(m);
+    initTracing(m);
     initVertices(m);
+    initArena(m); // After Paint, Path and Matrix
 
     initCanvas(m);
     initSurface(m);
@@ -1,6 +1,13 @@
 #include "common.h"
 #include <include/encode/SkPngEncoder.h>
+#include <src/shaders/SkImageShader.h>
 #include <pybind11/numpy.h>
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 
 template <>
@@ -364,3 +371,142 @@ py::dict ImageInfoToArrayInterface(
             throw std::runtime_error("Unsupported color type");
     }
 }
+
+
+void ParallelFor(int count, int threads, const std::function<void(int)>& fn) {
+    if (count <= 0)
+        return;
+    if (threads <= 0)
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    threads = std::min(threads, count);
+    if (threads == 1) {
+        for (int i = 0; i < count; ++i)
+            fn(i);
+        return;
+    }
+
+    std::atomic<int> next(0);
+    std::exception_ptr error;
+    std::mutex errorMutex;
+    auto worker = [&] () {
+        for (int i = next++; i < count; i = next++) {
+            try {
+                fn(i);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(errorMutex);
+                if (!error)
+                    error = std::current_exception();
+            }
+        }
+    };
+    std::vector<std::thread> pool;
+    pool.reserve(threads - 1);
+    for (int i = 1; i < threads; ++i)
+        pool.emplace_back(worker);
+    worker();
+    for (auto& thread : pool)
+        thread.join();
+    if (error)
+        std::rethrow_exception(error);
+}
+
+void ParallelForBands(int height, int threads, int rowsPerBand,
+                      const std::function<void(int, int)>& fn) {
+    rowsPerBand = std::max(1, rowsPerBand);
+    int bands = (height + rowsPerBand - 1) / rowsPerBand;
+    ParallelFor(bands, threads, [&] (int band) {
+        int top = band * rowsPerBand;
+        fn(top, std::min(height, top + rowsPerBand));
+    });
+}
+
+bool ScalePixelsParallel(sk_sp<const SkImage> src, const SkPixmap& dst,
+                         const SkSamplingOptions& sampling, int threads) {
+    if (!src || src->isTextureBacked() || !dst.addr() ||
+        dst.width() <= 0 || dst.height() <= 0)
+        return false;
+    // Decode lazy images once, not once per band.
+    if (src->isLazyGenerated())
+        src = src->makeRasterImage();
+    SkPixmap srcPixmap;
+    if (!src || !src->peekPixels(&srcPixmap))
+        return false;
+    // The rest mirrors SkPixmap::scalePixels, so every band samples exactly the
+    // source rows, including filter overlap, that a single-threaded scale
+    // would. Same-size scales are plain copies.
+    if (srcPixmap.dimensions() == dst.dimensions())
+        return ConvertPixelsParallel(srcPixmap, dst, threads);
+
+    // Scale unpremul pixels without premultiplying them: read the source as
+    // premul, write the destination as opaque and clamp as if unpremul.
+    SkPixmap dstPixmap = dst;
+    bool clampAsIfUnpremul = false;
+    if (srcPixmap.alphaType() == kUnpremul_SkAlphaType &&
+        dst.alphaType() == kUnpremul_SkAlphaType) {
+        srcPixmap.reset(srcPixmap.info().makeAlphaType(kPremul_SkAlphaType),
+                        srcPixmap.addr(), srcPixmap.rowBytes());
+        dstPixmap.reset(dst.info().makeAlphaType(kOpaque_SkAlphaType),
+                        dst.writable_addr(), dst.rowBytes());
+        clampAsIfUnpremul = true;
+    }
+    // Shares src pixels; src outlives the image below.
+    auto image = SkImages::RasterFromPixmap(srcPixmap, nullptr, nullptr);
+    // Build mip levels once, not once per band.
+    if (image && sampling.mipmap != SkMipmapMode::kNone)
+        image = image->withDefaultMipmaps();
+    if (!image)
+        return false;
+    auto scale = SkMatrix::RectToRect(
+        SkRect::Make(srcPixmap.bounds()), SkRect::Make(dstPixmap.bounds()));
+    SkPaint paint;
+    paint.setBlendMode(SkBlendMode::kSrc);
+    paint.setShader(SkImageShader::Make(
+        std::move(image), SkTileMode::kClamp, SkTileMode::kClamp, sampling,
+        &scale, clampAsIfUnpremul));
+    std::atomic<bool> ok(true);
+    {
+        py::gil_scoped_release release;
+        ParallelForBands(dstPixmap.height(), threads, 64,
+            [&] (int top, int bottom) {
+                SkPixmap band;
+                if (!dstPixmap.extractSubset(
+                        &band, SkIRect::MakeLTRB(
+                            0, top, dstPixmap.width(), bottom))) {
+                    ok = false;
+                    return;
+                }
+                auto canvas = SkCanvas::MakeRasterDirect(
+                    band.info(), band.writable_addr(), band.rowBytes());
+                if (!canvas) {
+                    ok = false;
+                    return;
+                }
+                canvas->translate(0, -top);
+                canvas->drawPaint(paint);
+            });
+    }
+    return ok;
+}
+
+bool ConvertPixelsParallel(const SkPixmap& src, const SkPixmap& dst,
+                           int threads) {
+    if (!src.addr() || !dst.addr() || src.dimensions() != dst.dimensions() ||
+        src.width() <= 0 || src.height() <= 0)
+        return false;
+    std::atomic<bool> ok(true);
+    {
+        py::gil_scoped_release release;
+        // Bands of about 256KB keep each worker's rows in cache.
+        int rowsPerBand = std::max<int>(
+            1, (256 << 10) / std::max<size_t>(1, dst.info().minRowBytes()));
+        ParallelForBands(dst.height(), threads, rowsPerBand,
+            [&] (int top, int bottom) {
+                SkPixmap band;
+                if (!dst.extractSubset(
+                        &band, SkIRect::MakeLTRB(0, top, dst.width(), bottom)) ||
+                    !src.readPixels(band, 0, top))
+                    ok = false;
+            });
+    }
+    return ok;
+}
@@ -0,0 +1,85 @@
+import pytest
+import skia
+
+
+@pytest.fixture
+def arena():
+    return skia.Arena()
+
+
+def test_Arena_objects(arena):
+    with arena:
+        assert isinstance(arena.Path(), skia.Path)
+        assert isinstance(arena.Paint(), skia.Paint)
+        assert isinstance(arena.Matrix(), skia.Matrix)
+    assert arena.capacity() == 3
+
+
+def test_Arena_reuse(arena):
+    with arena:
+        path = arena.Path()
+        path.addRect(skia.Rect(10, 10))
+        paint = arena.Paint(Color=skia.ColorRED)
+        matrix = arena.Matrix()
+        matrix.setTranslate(5, 5)
+        other = arena.Path()
+        assert other is not path
+    with arena:
+        assert arena.Path() is path
+        assert path.isEmpty()
+        assert arena.Paint() is paint
+        assert paint.getColor() == skia.ColorBLACK
+        assert arena.Matrix() is matrix
+        assert matrix.isIdentity()
+    assert arena.capacity() == 4
+
+
+def test_Arena_Paint_kwargs(arena):
+    with arena:
+        paint = arena.Paint(Color=skia.ColorBLUE, AntiAlias=True)
+        assert paint.getColor() == skia.ColorBLUE
+        assert paint.isAntiAlias()
+        with pytest.raises(KeyError):
+            arena.Paint(Unknown=1)
+        assert arena.Paint() is not paint
+    assert arena.capacity() == 2
+
+
+def test_Arena_nested(arena):
+    with arena:
+        path = arena.Path()
+        path.addRect(skia.Rect(10, 10))
+        paint = arena.Paint(Color=skia.ColorRED)
+        matrix = arena.Matrix()
+        with arena:
+            assert arena.Path() is not path
+            assert arena.Paint() is not paint
+            assert arena.Matrix() is not matrix
+        assert not path.isEmpty()
+        assert paint.getColor() == skia.ColorRED
+        with arena:
+            inner = arena.Path()
+        assert arena.Path() is inner
+    assert arena.capacity() == 6
+
+
+def test_Arena_draw(arena):
+    surface = skia.Surface(16, 16)
+    canvas = surface.getCanvas()
+    for i in range(4):
+        with arena:
+            path = arena.Path()
+            path.addRect(skia.Rect.MakeXYWH(i * 4, 0, 4, 4))
+            canvas.drawPath(path, arena.Paint(Color=skia.ColorWHITE))
+    assert arena.capacity() == 2
+    assert surface.toarray()[:4, :, 3].min() == 255
+
+
+def test_Arena_outside_scope(arena):
+    with pytest.raises(RuntimeError):
+        arena.Path()
+    with pytest.raises(RuntimeError):
+        arena.Paint(Color=skia.ColorRED)
+    with pytest.raises(RuntimeError):
+        arena.Matrix()
+    assert arena.capacity() == 0
@@ -399,6 +399,45 @@ def test_Canvas_drawTextOnPath(canvas, args):
     canvas.drawTextOnPath(*args)
 
 
+@pytest.mark.parametrize('warp', [False, True])
+def test_Canvas_drawTextOnPaths(canvas, warp):
+    path = skia.Path()
+    path.moveTo(10, 100)
+    path.quadTo(150, 10, 300, 100)
+    labels = [
+        ('foo', path),
+        ('bar', path, 10),
+        ('baz', path, (10, -2)),
+        ('empty', skia.Path()),
+    ]
+    canvas.drawTextOnPaths(labels, skia.Font(), skia.Paint(), warp=warp)
+
+
+@pytest.mark.parametrize('warp', [False, True])
+def test_Canvas_drawTextOnPaths_pixels(warp):
+    path = skia.Path()
+    path.moveTo(10, 100)
+    path.quadTo(150, 10, 300, 100)
+    font = skia.Font(skia.Typeface('monospace'), 24)
+    paint = skia.Paint(Color=skia.ColorBLACK)
+
+    def render(draw):
+        surface = skia.Surface(320, 120)
+        canvas = surface.getCanvas()
+        canvas.clear(skia.ColorWHITE)
+        draw(canvas)
+        return surface.toarray()
+
+    actual = render(lambda canvas: canvas.drawTextOnPaths(
+        [('hello', path, 10)], font, paint, warp=warp))
+    assert (actual[:, :, :3] < 128).any()
+    if not warp:
+        blob = skia.TextBlob.MakeOnPath('hello', path, font, 10)
+        expected = render(
+            lambda canvas: canvas.drawTextBlob(blob, 0, 0, paint))
+        np.testing.assert_array_equal(actual, expected)
+
+
 @pytest.mark.parametrize('args', [
     (skia.TextBlob('foo', skia.Font()), 0, 0, skia.Paint(),),
     (skia.TextBlob('foo', skia.Font()), 0, 0, skia.Paint(),),
@@ -425,6 +464,14 @@ def test_Canvas_drawVertices(canvas, vertices, args):
     canvas.drawVertices(vertices, *args)
 
 
+def test_Canvas_drawVertices_chunks(canvas):
+    positions = np.random.rand(70000, 2).astype(np.float32) * 100
+    chunks = skia.Vertices.MakeFromArrays(
+        skia.Vertices.kTriangles_VertexMode, positions,
+        indices=np.arange(69999, dtype=np.uint32))
+    canvas.drawVertices(chunks, skia.Paint())
+
+
 @pytest.mark.parametrize('args', [
     (
         [skia.Point(x, x) for x in range(12)],
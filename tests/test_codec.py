@@ -41,6 +41,31 @@ def test_Codec_getInfo(codec):
     assert isinstance(codec.getInfo(), skia.ImageInfo)
 
 
+def test_Codec_getICCProfile(codec):
+    profile = codec.getICCProfile()
+    assert profile is None or isinstance(profile, bytes)
+
+
+def test_Codec_getICCProfile_cache():
+    p3 = skia.ColorSpace.MakeRGB(
+        skia.cms.NamedTransferFn.kSRGB, skia.cms.NamedGamut.kDisplayP3)
+    surface = skia.Surface.MakeRaster(
+        skia.ImageInfo.MakeN32Premul(4, 4, p3))
+    encoded = surface.makeImageSnapshot().encodeToData()
+    skia.ColorSpace.PurgeICCCache(True)
+    codecs = [skia.Codec(encoded) for _ in range(3)]
+    profile = codecs[0].getICCProfile()
+    assert isinstance(profile, bytes)
+    assert all(codec.getInfo().colorSpace() == p3 for codec in codecs)
+    colorspaces = [
+        skia.ColorSpace.MakeFromICC(codec.getICCProfile()) for codec in codecs]
+    assert all(cs == p3 for cs in colorspaces)
+    stats = skia.ColorSpace.GetICCCacheStats()
+    assert stats['misses'] == 1
+    assert stats['hits'] == 2
+    assert stats['count'] == 1
+
+
 def test_Codec_dimensions(codec):
     assert isinstance(codec.dimensions(), skia.ISize)
 
@@ -1,5 +1,6 @@
 import skia
 import pytest
+import numpy as np
 
 
 @pytest.fixture
@@ -47,3 +48,60 @@ def test_ColorSpace_makeColorSpin(colorspace):
 
 def test_ColorSpace_isSRGB(colorspace):
     assert isinstance(colorspace.isSRGB(), bool)
+
+
+def test_ColorSpaceXform_init():
+    xform = skia.ColorSpaceXform(
+        skia.ColorSpace.MakeSRGB(), skia.ColorSpace.MakeSRGBLinear())
+    assert xform.src() == skia.ColorSpace.MakeSRGB()
+    assert xform.dst() == skia.ColorSpace.MakeSRGBLinear()
+
+
+@pytest.mark.parametrize('threads', [1, 0])
+def test_ColorSpaceXform_apply_float(threads):
+    colors = np.array([[0.5, 0.5, 0.5, 1.0]] * 100000, dtype=np.float32)
+    xform = skia.ColorSpaceXform(None, skia.ColorSpace.MakeSRGBLinear())
+    assert xform.apply(colors, threads=threads) is colors
+    assert np.allclose(colors[:, :3], 0.214, atol=1e-3)
+    assert np.all(colors[:, 3] == 1.0)
+    skia.ColorSpaceXform(skia.ColorSpace.MakeSRGBLinear(), None).apply(colors)
+    assert np.allclose(colors[:, :3], 0.5, atol=1e-3)
+
+
+def test_ColorSpaceXform_apply_uint8():
+    pixels = np.full((4, 5, 4), 255, dtype=np.uint8)
+    xform = skia.ColorSpaceXform(None, skia.ColorSpace.MakeSRGBLinear())
+    xform.apply(pixels, skia.kPremul_AlphaType)
+    assert np.all(pixels == 255)
+    with pytest.raises(ValueError):
+        xform.apply(np.zeros((4, 3), dtype=np.uint8))
+
+
+def test_ColorSpace_MakeFromICC_invalid():
+    assert skia.ColorSpace.MakeFromICC(b'not a profile') is None
+
+
+def test_ColorSpaceXform_cache():
+    linear = skia.ColorSpace.MakeSRGBLinear()
+    skia.ColorSpaceXform.PurgeCache(resetStats=True)
+    limit = skia.ColorSpaceXform.GetCacheStats()['limit']
+    skia.ColorSpaceXform.SetCacheLimit(1)
+    try:
+        xform = skia.ColorSpaceXform(None, linear)
+        assert skia.ColorSpaceXform(None, linear) is xform
+        skia.ColorSpaceXform(linear, None)
+        stats = skia.ColorSpaceXform.GetCacheStats()
+        assert stats == {'hits': 1, 'misses': 2, 'count': 1, 'limit': 1}
+        assert skia.ColorSpaceXform(None, linear) is not xform
+    finally:
+        skia.ColorSpaceXform.SetCacheLimit(limit)
+
+
+def test_ColorSpace_SetICCCacheLimit():
+    limit = skia.ColorSpace.GetICCCacheStats()['limit']
+    skia.ColorSpace.SetICCCacheLimit(0)
+    try:
+        skia.ColorSpace.MakeFromICC(b'not a profile')
+        assert skia.ColorSpace.GetICCCacheStats()['count'] == 0
+    finally:
+        skia.ColorSpace.SetICCCacheLimit(limit)
@@ -0,0 +1,96 @@
+import concurrent.futures
+
+import pytest
+import skia
+
+
+class GreenPicture(skia.Picture):
+    def playback(self, canvas):
+        canvas.drawRect(skia.Rect(32, 32), skia.Paint(Color=skia.ColorGREEN))
+
+    def cullRect(self):
+        return skia.Rect(32, 32)
+
+    def approximateOpCount(self, nested=False):
+        # Large enough that the recorder keeps a reference instead of
+        # playing the picture inline.
+        return 100
+
+    def approximateBytesUsed(self):
+        return 0
+
+
+@pytest.fixture
+def deferred():
+    with skia.DeferredCanvas(32, 32, maxPending=1) as deferred:
+        yield deferred
+
+
+def test_DeferredCanvas_init():
+    info = skia.ImageInfo.MakeN32Premul(16, 8)
+    with skia.DeferredCanvas(info) as deferred:
+        assert deferred.imageInfo() == info
+
+
+def test_DeferredCanvas_endFrame(deferred):
+    canvas = deferred.beginFrame()
+    assert isinstance(canvas, skia.Canvas)
+    canvas.clear(skia.ColorRED)
+    future = deferred.endFrame()
+    assert isinstance(future, concurrent.futures.Future)
+    image = future.result(timeout=10)
+    assert isinstance(image, skia.Image)
+    assert image.width() == 32
+    array = image.toarray(colorType=skia.kRGBA_8888_ColorType)
+    assert array[0, 0].tolist() == [255, 0, 0, 255]
+
+
+def test_DeferredCanvas_python_picture(deferred):
+    picture = GreenPicture()
+    canvas = deferred.beginFrame()
+    canvas.drawPicture(picture)
+    image = deferred.endFrame().result(timeout=10)
+    array = image.toarray(colorType=skia.kRGBA_8888_ColorType)
+    assert array[16, 16].tolist() == [0, 255, 0, 255]
+
+
+def test_DeferredCanvas_close_in_callback():
+    deferred = skia.DeferredCanvas(8, 8)
+    closed = []
+
+    def callback(future):
+        deferred.close()
+        closed.append(deferred.isClosed())
+
+    deferred.beginFrame()
+    future = deferred.endFrame()
+    future.add_done_callback(callback)
+    future.result(timeout=10)
+    deferred.wait()
+    deferred.close()
+    assert closed == [True]
+
+
+def test_DeferredCanvas_backpressure(deferred):
+    futures = []
+    for i in range(8):
+        canvas = deferred.beginFrame()
+        canvas.clear(skia.Color(i, 0, 0))
+        futures.append(deferred.endFrame())
+    deferred.wait()
+    assert deferred.pending() == 0
+    assert [f.result().toarray(colorType=skia.kRGBA_8888_ColorType)[0, 0, 0]
+            for f in futures] == list(range(8))
+
+
+def test_DeferredCanvas_errors(deferred):
+    with pytest.raises(RuntimeError):
+        deferred.endFrame()
+    deferred.beginFrame()
+    with pytest.raises(RuntimeError):
+        deferred.beginFrame()
+    deferred.endFrame()
+    deferred.close()
+    assert deferred.isClosed()
+    with pytest.raises(RuntimeError):
+        deferred.beginFrame()
@@ -0,0 +1,61 @@
+import skia
+import pytest
+import numpy as np
+
+
+def test_Graphics_FontCacheLimit():
+    limit = skia.Graphics.GetFontCacheLimit()
+    assert skia.Graphics.SetFontCacheLimit(limit // 2) == limit
+    assert skia.Graphics.GetFontCacheLimit() == limit // 2
+    skia.Graphics.SetFontCacheLimit(limit)
+
+
+def test_Graphics_GetFontCacheUsed():
+    assert isinstance(skia.Graphics.GetFontCacheUsed(), int)
+    assert isinstance(skia.Graphics.GetFontCacheCountUsed(), int)
+
+
+def test_Graphics_ResourceCacheTotalByteLimit():
+    limit = skia.Graphics.GetResourceCacheTotalByteLimit()
+    assert skia.Graphics.SetResourceCacheTotalByteLimit(limit) == limit
+    assert isinstance(skia.Graphics.GetResourceCacheTotalBytesUsed(), int)
+
+
+def test_Graphics_PurgeAllCaches():
+    used = skia.Graphics.GetResourceCacheTotalBytesUsed()
+    skia.Graphics.PurgeAllCaches()
+    assert skia.Graphics.GetResourceCacheTotalBytesUsed() <= used
+
+
+@pytest.mark.parametrize('detailed', [False, True])
+def test_Graphics_DumpMemoryStatistics(detailed):
+    surface = skia.Surface(64, 64)
+    with surface as canvas:
+        canvas.drawString('Hello', 10, 32, skia.Font(skia.Typeface(''), 12),
+                          skia.Paint())
+    stats = skia.Graphics.DumpMemoryStatistics(detailed)
+    assert isinstance(stats, dict)
+    for name, values in stats.items():
+        assert isinstance(name, str)
+        assert isinstance(values, dict)
+
+
+def test_Graphics_CollectMemoryStatistics():
+    recorder = skia.PictureRecorder()
+    canvas = recorder.beginRecording(skia.Rect(100, 100))
+    canvas.drawRect(skia.Rect(10, 10, 50, 50), skia.Paint())
+    picture = recorder.finishRecordingAsPicture()
+    path = skia.Path().addCircle(50, 50, 20)
+    stats = skia.Graphics.CollectMemoryStatistics(
+        pictures=[picture], paths=[path])
+    assert stats['skia/sk_picture/0']['size'] == picture.approximateBytesUsed()
+    assert stats['skia/sk_path/0']['size'] == path.approximateBytesUsed()
+
+
+def test_Graphics_CollectMemoryStatistics_asArrays():
+    path = skia.Path().addCircle(50, 50, 20)
+    stats = skia.Graphics.CollectMemoryStatistics(paths=[path], asArrays=True)
+    assert set(stats) == {'dumpName', 'valueName', 'units', 'value'}
+    assert stats['value'].dtype == np.uint64
+    assert len(stats['dumpName']) == len(stats['value'])
+    assert 'skia/sk_path/0' in stats['dumpName']
@@ -418,6 +418,12 @@ def test_GrContext_checkAsyncWorkCompletion(context):
     context.checkAsyncWorkCompletion()
 
 
+@pytest.mark.parametrize('asArrays', [False, True])
+def test_GrContext_dumpMemoryStatistics(context, asArrays):
+    assert isinstance(
+        context.dumpMemoryStatistics(asArrays=asArrays), dict)
+
+
 def test_GrContext_supportsDistanceFieldText(context):
     assert isinstance(context.supportsDistanceFieldText(), bool)
 
@@ -586,6 +592,55 @@ def test_GrDirectContext_MakeMock():
         skia.GrDirectContext)
 
 
+def test_GrDirectContext_MakeMock_draw():
+    context = skia.GrDirectContext.MakeMock(skia.GrMockOptions())
+    info = skia.ImageInfo.Make(
+        64, 64, skia.kRGBA_8888_ColorType, skia.kPremul_AlphaType)
+    surface = skia.Surface.MakeRenderTarget(context, skia.Budgeted.kYes, info)
+    with surface as canvas:
+        canvas.drawRect(skia.Rect(10, 10, 30, 30), skia.Paint())
+    context.flushAndSubmit()
+    resource_count, resource_bytes = context.getResourceCacheUsage()
+    assert resource_count > 0
+    assert resource_bytes > 0
+
+
+def test_GrDiskPersistentCache_store_load(tmp_path):
+    key = skia.Data(b'key')
+    cache = skia.GrDiskPersistentCache(str(tmp_path))
+    assert cache.load(key) is None
+    assert cache.misses() == 1
+    cache.store(key, skia.Data(b'program'))
+    assert cache.stores() == 1
+    other = skia.GrDiskPersistentCache(str(tmp_path))
+    assert bytes(other.load(key)) == b'program'
+    assert other.hits() == 1
+
+
+def test_GrContextOptions_fPersistentCache(opengl_context, tmp_path):
+    cache = skia.GrDiskPersistentCache(str(tmp_path))
+    options = skia.GrContextOptions()
+    options.fPersistentCache = cache
+    options.fShaderCacheStrategy = skia.GrContextOptions.kBackendSource
+    assert options.fPersistentCache is cache
+    assert cache.directory() == str(tmp_path)
+
+    # The mock backend compiles no programs, so draw through GL.
+    def draw():
+        context = skia.GrDirectContext.MakeGL(options)
+        if context is None:
+            pytest.skip('Failed to create GrDirectContext')
+        surface = skia.Surface.MakeRenderTarget(
+            context, skia.Budgeted.kNo, skia.ImageInfo.MakeN32Premul(32, 32))
+        surface.getCanvas().drawCircle(16, 16, 8, skia.Paint(AntiAlias=True))
+        context.flushAndSubmit()
+
+    draw()
+    assert cache.stores() > 0
+    draw()
+    assert cache.hits() > 0
+
+
 @pytest.fixture(scope='module')
 def gl_texture_info():
     return skia.GrGLTextureInfo()
@@ -100,6 +100,144 @@ def test_Image_resize(image):
     assert resized.height() == 40
 
 
+@pytest.mark.parametrize('options', [
+    skia.SamplingOptions(),
+    skia.SamplingOptions(skia.FilterMode.kLinear),
+    skia.SamplingOptions(skia.FilterMode.kLinear, skia.MipmapMode.kLinear),
+    skia.SamplingOptions(skia.CubicResampler.Mitchell()),
+])
+@pytest.mark.parametrize('size', [(50, 40), 'same'])
+def test_Image_resize_threads(image, options, size):
+    width, height = image.dimensions() if size == 'same' else size
+    expected = image.resize(width, height, options)
+    resized = image.resize(width, height, options, threads=4)
+    assert np.array_equal(np.array(resized), np.array(expected))
+
+
+@pytest.mark.parametrize('options', [
+    skia.SamplingOptions(skia.FilterMode.kLinear),
+    skia.SamplingOptions(skia.CubicResampler.Mitchell()),
+])
+def test_Image_resize_threads_unpremul(options):
+    array = np.random.default_rng(0).integers(
+        0, 256, (64, 48, 4), dtype=np.uint8)
+    image = skia.Image.fromarray(
+        array, skia.kRGBA_8888_ColorType, skia.kUnpremul_AlphaType)
+    expected = image.resize(30, 50, options)
+    resized = image.resize(30, 50, options, threads=4)
+    assert resized.alphaType() == skia.kUnpremul_AlphaType
+    assert np.array_equal(np.array(resized), np.array(expected))
+
+
+@pytest.mark.parametrize('kwargs', [
+    {},
+    {'threads': 0},
+    {'sampling': skia.SamplingOptions(skia.CubicResampler.Mitchell())},
+])
+def test_Image_buildPyramid(image, kwargs):
+    levels = image.buildPyramid(3, **kwargs)
+    assert len(levels) == 3
+    assert all(isinstance(level, skia.Image) for level in levels)
+    assert levels[0].width() == image.width() // 2
+    assert levels[2].height() == image.height() // 8
+
+
+@pytest.mark.parametrize('alphaType', [
+    skia.kPremul_AlphaType, skia.kUnpremul_AlphaType])
+def test_Image_buildPyramid_threads(alphaType):
+    array = np.random.default_rng(0).integers(
+        0, 256, (64, 48, 4), dtype=np.uint8)
+    image = skia.Image.fromarray(array, skia.kRGBA_8888_ColorType, alphaType)
+    sampling = skia.SamplingOptions(skia.CubicResampler.Mitchell())
+    expected = image.buildPyramid(sampling=sampling, asArray=True)
+    levels = image.buildPyramid(sampling=sampling, threads=4, asArray=True)
+    assert len(levels) == len(expected)
+    for level, want in zip(levels, expected):
+        assert np.array_equal(level, want)
+
+
+def test_Image_buildPyramid_asArray(image):
+    arrays = image.buildPyramid(asArray=True)
+    assert arrays[-1].shape[:2] == (1, 1)
+    assert arrays[0].shape[:2] == (image.height() // 2, image.width() // 2)
+    assert arrays[0].base is arrays[1].base
+
+
+def test_Image_convert_threads(image):
+    expected = image.convert(skia.kRGBA_F16_ColorType, skia.kPremul_AlphaType)
+    converted = image.convert(
+        skia.kRGBA_F16_ColorType, skia.kPremul_AlphaType, threads=0)
+    assert np.array_equal(np.array(converted), np.array(expected))
+
+
+def test_Image_FromYUV420Arrays():
+    y = np.full((31, 40), 128, dtype=np.uint8)
+    u = np.full((16, 20), 128, dtype=np.uint8)
+    v = np.full((16, 20), 128, dtype=np.uint8)
+    image = skia.Image.FromYUV420Arrays(
+        y, u, v, skia.YUVColorSpace.kJPEG_YUVColorSpace)
+    assert image.dimensions() == skia.ISize(40, 31)
+    array = image.toarray(colorType=skia.kRGBA_8888_ColorType)
+    assert np.all(np.abs(array[..., :3].astype(int) - 128) <= 1)
+    assert np.all(array[..., 3] == 255)
+
+
+def test_Image_FromYUV420Arrays_shape():
+    y = np.zeros((32, 40), dtype=np.uint8)
+    with pytest.raises(ValueError):
+        skia.Image.FromYUV420Arrays(y, y, y)
+
+
+def test_Image_FromYUV420Arrays_dtype():
+    y = np.zeros((32, 40), dtype=np.float32)
+    u = np.zeros((16, 20), dtype=np.uint8)
+    with pytest.raises(TypeError):
+        skia.Image.FromYUV420Arrays(y, u, u)
+
+
+def test_Image_decodeAsync(png_path):
+    image = skia.Image.open(png_path)
+    assert image.isLazyGenerated()
+    raster = image.decodeAsync().result(timeout=10)
+    assert isinstance(raster, skia.Image)
+    assert not raster.isLazyGenerated()
+    assert raster.dimensions() == image.dimensions()
+
+
+def test_Image_predecode(png_path, image):
+    lazy = [skia.Image.open(png_path) for _ in range(4)]
+    rasters = skia.Image.predecode(lazy + [image], threads=2)
+    assert len(rasters) == 5
+    assert all(not raster.isLazyGenerated() for raster in rasters)
+    assert np.array_equal(np.array(rasters[0]), np.array(rasters[3]))
+
+
+class RedPicture(skia.Picture):
+    def playback(self, canvas):
+        canvas.clear(skia.ColorRED)
+
+    def cullRect(self):
+        return skia.Rect(8, 8)
+
+    def approximateOpCount(self, nested=False):
+        return 1
+
+    def approximateBytesUsed(self):
+        return 0
+
+
+def test_Image_predecode_python_picture(png_path):
+    picture = RedPicture()
+    lazy = skia.Image.MakeFromPicture(picture, skia.ISize(8, 8))
+    rasters = skia.Image.predecode(
+        [lazy, skia.Image.open(png_path)], threads=2)
+    assert not rasters[0].isLazyGenerated()
+    assert rasters[0].toarray(colorType=skia.kRGBA_8888_ColorType)[
+        4, 4].tolist() == [255, 0, 0, 255]
+    raster = lazy.decodeAsync().result(timeout=10)
+    assert not raster.isLazyGenerated()
+
+
 def test_Image_repr(image):
     assert isinstance(repr(image), str)
 
@@ -236,6 +374,13 @@ def test_Image_scalePixels(image):
     assert isinstance(image.scalePixels(dst), bool)
 
 
+def test_Image_scalePixels_threads(image):
+    array = np.zeros((300, 200, 4), dtype=np.uint8)
+    dst = skia.Pixmap(array, image.colorType(), image.alphaType())
+    assert image.scalePixels(dst, threads=0)
+    assert array.any()
+
+
 @pytest.mark.parametrize('args', [
     (skia.EncodedImageFormat.kJPEG, 100),
     tuple(),
@@ -0,0 +1,86 @@
+import skia
+import pytest
+import numpy as np
+
+
+VS = """
+Varyings main(const Attributes attrs) {
+    Varyings v;
+    v.position = attrs.pos;
+    return v;
+}
+"""
+
+FS = """
+float2 main(const Varyings v, out half4 color) {
+    color = half4(1, 0, 0, 1);
+    return v.position;
+}
+"""
+
+
+@pytest.fixture
+def spec():
+    return skia.MeshSpecification.Make(
+        [skia.MeshSpecification.Attribute(
+            skia.MeshSpecification.Attribute.Type.kFloat2, 0, 'pos')],
+        8, [], VS, FS)
+
+
+@pytest.fixture
+def positions():
+    return np.array([[0, 0], [64, 0], [0, 64], [64, 64]], dtype=np.float32)
+
+
+def test_MeshSpecification_Make(spec):
+    assert isinstance(spec, skia.MeshSpecification)
+    assert spec.stride() == 8
+    assert spec.uniformSize() == 0
+
+
+def test_MeshSpecification_Make_error():
+    with pytest.raises(ValueError):
+        skia.MeshSpecification.Make([], 8, [], 'bad', FS)
+
+
+def test_Mesh_Make(spec, positions):
+    vertices = skia.Mesh.MakeVertexBuffer(positions)
+    assert vertices.size() == positions.nbytes
+    mesh = skia.Mesh.Make(
+        spec, skia.Mesh.Mode.kTriangleStrip, vertices, 4, 0, None, [],
+        skia.Rect(64, 64))
+    assert mesh.isValid()
+    assert mesh.vertexCount() == 4
+
+
+def test_Mesh_MakeIndexed(spec, positions):
+    vertices = skia.Mesh.MakeVertexBuffer(positions)
+    indices = skia.Mesh.MakeIndexBuffer(
+        np.array([0, 1, 2, 1, 3, 2], dtype=np.uint16))
+    mesh = skia.Mesh.MakeIndexed(
+        spec, skia.Mesh.Mode.kTriangles, vertices, 4, 0, indices, 6, 0, None,
+        [], skia.Rect(64, 64))
+    assert mesh.indexCount() == 6
+
+
+def test_Mesh_update(spec, positions):
+    surface = skia.Surface(64, 64)
+    vertices = skia.Mesh.MakeVertexBuffer(np.zeros_like(positions))
+    mesh = skia.Mesh.Make(
+        spec, skia.Mesh.Mode.kTriangleStrip, vertices, 4, 0, None, [],
+        skia.Rect(64, 64))
+    vertices.update(positions)
+    with surface as canvas:
+        canvas.drawMesh(mesh, skia.Paint())
+    assert surface.toarray()[32, 32, 3] == 255
+    with pytest.raises(RuntimeError):
+        vertices.update(positions, offset=8)
+
+
+def test_Blender_Mode():
+    assert isinstance(skia.Blender.Mode(skia.BlendMode.kSrcOver), skia.Blender)
+
+
+def test_Blender_Arithmetic():
+    assert isinstance(
+        skia.Blender.Arithmetic(0, 1, 1, 0, False), skia.Blender)
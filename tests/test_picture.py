@@ -1,3 +1,4 @@
+import numpy as np
 import skia
 import pytest
 
@@ -15,6 +16,54 @@ def test_Picture_playback(picture, canvas):
     picture.playback(canvas)
 
 
+@pytest.fixture
+def bbh_picture(recorder):
+    canvas = recorder.beginRecording(skia.Rect(100, 100), skia.RTreeFactory()())
+    canvas.drawRect(skia.Rect(0, 0, 10, 10), skia.Paint(Color=skia.ColorRED))
+    canvas.drawRect(skia.Rect(50, 50, 60, 60), skia.Paint(Color=skia.ColorBLUE))
+    return recorder.finishRecordingAsPicture()
+
+
+@pytest.mark.parametrize('rects, expected', [
+    ([skia.Rect(0, 0, 20, 20)], 1),
+    ([skia.Rect(0, 0, 20, 20), skia.Rect(5, 5, 25, 25)], 1),
+    ([skia.Rect(0, 0, 20, 20), skia.Rect(55, 55, 70, 70)], 2),
+    ([skia.Rect(20, 20, 40, 40)], 0),
+    ([], 0),
+])
+def test_Picture_playbackRegions(bbh_picture, rects, expected):
+    surface = skia.Surface(100, 100)
+    assert bbh_picture.playbackRegions(surface.getCanvas(), rects) == expected
+    array = surface.toarray(colorType=skia.kRGBA_8888_ColorType)
+    assert (array[5, 5, 0] == 255) == any(r.contains(5, 5) for r in rects)
+    assert (array[52, 52, 2] == 255) == any(
+        r.contains(52, 52) for r in rects)
+
+
+def test_Picture_opStats(bbh_picture):
+    stats = bbh_picture.opStats()
+    assert stats['DrawRect']['count'] == 2
+    assert stats['DrawRect']['bytes'] > 0
+    assert stats['DrawRect']['area'] >= 200
+
+
+def test_Picture_opBounds(bbh_picture):
+    bounds = bbh_picture.opBounds()
+    assert bounds.dtype == np.float32
+    assert bounds.shape == (2, 4)
+    expected = np.array([[0, 0, 10, 10], [50, 50, 60, 60]])
+    assert np.all(bounds[:, :2] <= expected[:, :2])
+    assert np.all(bounds[:, 2:] >= expected[:, 2:])
+
+
+def test_Picture_opBounds_empty():
+    recorder = skia.PictureRecorder()
+    recorder.beginRecording(skia.Rect(100, 100))
+    picture = recorder.finishRecordingAsPicture()
+    assert picture.opBounds().shape == (0, 4)
+    assert picture.opStats() == {}
+
+
 def test_Picture_cullRect(picture):
     assert isinstance(picture.cullRect(), skia.Rect)
 
@@ -27,6 +76,121 @@ def test_Picture_serialize(picture):
     assert isinstance(picture.serialize(), skia.Data)
 
 
+@pytest.fixture
+def asset_pictures(image):
+    font = skia.Font(skia.Typeface('monospace'), 12)
+    pictures = []
+    for i in range(3):
+        recorder = skia.PictureRecorder()
+        canvas = recorder.beginRecording(skia.Rect(100, 100))
+        canvas.drawImage(image, i, i)
+        canvas.drawString('tile %d' % i, 10, 50, font, skia.Paint())
+        pictures.append(recorder.finishRecordingAsPicture())
+    return pictures
+
+
+def draw_picture(picture):
+    surface = skia.Surface(100, 100)
+    surface.getCanvas().drawPicture(picture)
+    return surface.toarray()
+
+
+def test_Picture_serialize_store(asset_pictures):
+    store = skia.PictureAssetStore()
+    tiles = [picture.serialize(store) for picture in asset_pictures]
+    assert store.typefaceCount() == 1
+    assert store.imageCount() == 1
+
+    restored = skia.PictureAssetStore.MakeFromData(store.serialize())
+    assert restored.typefaceCount() == 1
+    assert restored.imageCount() == 1
+    for picture, tile in zip(asset_pictures, tiles):
+        assert isinstance(tile, skia.Data)
+        result = skia.Picture.MakeFromData(tile, restored)
+        np.testing.assert_array_equal(
+            draw_picture(result), draw_picture(picture))
+
+
+def test_PictureAssetStore_unencodable_image():
+    # PNG cannot hold two-channel images.
+    image = skia.Image.fromarray(
+        np.zeros((8, 8, 2), dtype=np.uint8), skia.kR8G8_unorm_ColorType)
+    recorder = skia.PictureRecorder()
+    recorder.beginRecording(skia.Rect(10, 10)).drawImage(image, 0, 0)
+    picture = recorder.finishRecordingAsPicture()
+    store = skia.PictureAssetStore()
+    assert isinstance(picture.serialize(store), skia.Data)
+    restored = skia.PictureAssetStore.MakeFromData(store.serialize())
+    assert restored.imageCount() == store.imageCount()
+
+
+def test_PictureAssetStore_MakeFromData_invalid():
+    with pytest.raises(ValueError):
+        skia.PictureAssetStore.MakeFromData(skia.Data(b'invalid'))
+
+
+def make_redundant_picture():
+    recorder = skia.PictureRecorder()
+    canvas = recorder.beginRecording(skia.Rect(10, 10))
+    for color in (skia.ColorRED, skia.ColorGREEN, skia.ColorBLUE):
+        canvas.drawRect(skia.Rect(2, 2, 8, 8), skia.Paint(Color=color))
+    inner = recorder.finishRecordingAsPicture()
+
+    canvas = recorder.beginRecording(skia.Rect(100, 100))
+    for i in range(10):
+        canvas.save()
+        canvas.translate(i * 10, 0)
+        canvas.drawPicture(inner)
+        canvas.restore()
+        canvas.save()
+        canvas.clipRect(skia.Rect(0, 0, 5, 5))
+        canvas.drawRect(skia.Rect(50, 50, 60, 60), skia.Paint())
+        canvas.restore()
+        canvas.drawRect(skia.Rect(200, 200, 210, 210), skia.Paint())
+    return recorder.finishRecordingAsPicture()
+
+
+@pytest.mark.parametrize('bbh', [None, skia.RTreeFactory()()])
+def test_Picture_optimize(bbh):
+    picture = make_redundant_picture()
+    optimized = picture.optimize(bbh)
+    assert isinstance(optimized, skia.Picture)
+    assert optimized.cullRect() == picture.cullRect()
+    assert (optimized.approximateOpCount(True) <
+            picture.approximateOpCount(True))
+    assert 'DrawPicture' in picture.opStats()
+    assert 'DrawPicture' not in optimized.opStats()
+    np.testing.assert_array_equal(
+        draw_picture(optimized), draw_picture(picture))
+
+
+def test_Picture_optimize_negative_cull():
+    recorder = skia.PictureRecorder()
+    canvas = recorder.beginRecording(skia.Rect(10, 10))
+    for color in (skia.ColorRED, skia.ColorGREEN, skia.ColorBLUE):
+        canvas.drawRect(skia.Rect(2, 2, 8, 8), skia.Paint(Color=color))
+    inner = recorder.finishRecordingAsPicture()
+
+    canvas = recorder.beginRecording(
+        skia.Rect(-50, -50, 50, 50), skia.RTreeFactory()())
+    for x, y in [(-40, -40), (-40, 20), (20, -40), (20, 20)]:
+        canvas.save()
+        canvas.translate(x, y)
+        canvas.drawPicture(inner)
+        canvas.restore()
+    picture = recorder.finishRecordingAsPicture()
+    optimized = picture.optimize()
+    assert 'DrawPicture' not in optimized.opStats()
+    assert optimized.opStats()['DrawRect']['count'] == 12
+
+    def draw(picture):
+        surface = skia.Surface(100, 100)
+        surface.getCanvas().translate(50, 50)
+        surface.getCanvas().drawPicture(picture)
+        return surface.toarray()
+    np.testing.assert_array_equal(draw(optimized), draw(picture))
+
+
 def test_Picture_approximateOpCount(picture):
     assert isinstance(picture.approximateOpCount(), int)
 
@@ -171,6 +171,37 @@ def test_Pixmap_scalePixels(pixmap):
     assert isinstance(pixmap.scalePixels(dst), bool)
 
 
+def test_Pixmap_scalePixels_threads(pixmap):
+    pixmap.erase(0xFF00FF00)
+    info = pixmap.info().makeWH(130, 70)
+    dst = skia.Pixmap(info, bytearray(info.computeMinByteSize()),
+                      info.minRowBytes())
+    assert pixmap.scalePixels(
+        dst, skia.SamplingOptions(skia.FilterMode.kLinear), threads=2)
+    assert dst.getColor(129, 69) == 0xFF00FF00
+
+
+@pytest.mark.parametrize('colorType, alphaType, dtype, channels', [
+    (skia.kRGBA_F16_ColorType, skia.kPremul_AlphaType, np.float16, 4),
+    (skia.kRGBA_F32_ColorType, skia.kUnpremul_AlphaType, np.float32, 4),
+    (skia.kBGRA_8888_ColorType, skia.kPremul_AlphaType, np.uint8, 4),
+    (skia.kGray_8_ColorType, skia.kOpaque_AlphaType, np.uint8, None),
+])
+def test_Pixmap_convertTo(pixmap, colorType, alphaType, dtype, channels):
+    pixmap.erase(0xFFFF0000)
+    shape = (pixmap.height(), pixmap.width())
+    if channels:
+        shape += (channels,)
+    dst = np.zeros(shape, dtype=dtype)
+    assert pixmap.convertTo(dst, colorType, alphaType, threads=4) is dst
+    assert dst.any()
+
+
+def test_Pixmap_convertTo_shape_mismatch(pixmap):
+    with pytest.raises(ValueError):
+        pixmap.convertTo(np.zeros((10, 10, 4), dtype=np.uint8))
+
+
 def test_Pixmap_erase(pixmap):
     assert isinstance(pixmap.erase(0xFFFFFFFF), bool)
 
@@ -1,5 +1,6 @@
 import skia
 import pytest
+import numpy as np
 
 @pytest.fixture(scope='session')
 def runtime_effect():
@@ -153,3 +154,132 @@ def test_builder_uniform_float4_set(builder_with_uniforms):
 def test_builder_uniform_shader_set(builder_with_uniforms):
     assert builder_with_uniforms.child("iImage").type == skia.RuntimeEffect.ChildType.kShader
     builder_with_uniforms.setChild("iImage", skia.Bitmap().makeShader())
+
+
+@pytest.fixture
+def uniform_buffer(builder_with_uniforms):
+    return skia.RuntimeEffectUniformBuffer(builder_with_uniforms.effect())
+
+def test_RuntimeEffectUniformBuffer_init(builder_with_uniforms):
+    buffer = skia.UniformBuffer(
+        builder_with_uniforms.effect(), {'iFloat': 1.0, 'iInteger': 2})
+    assert len(buffer) == 5
+    assert buffer['iFloat'][0] == 1.0
+    assert buffer['iInteger'][0] == 2
+
+def test_RuntimeEffectUniformBuffer_index(uniform_buffer):
+    assert uniform_buffer.index('iFloat2') == 2
+    with pytest.raises(KeyError):
+        uniform_buffer.index('iDoesNotExist')
+
+@pytest.mark.parametrize('value', [
+    (1, 2),
+    skia.V2(1, 2),
+    np.array([1, 2], dtype=np.float32),
+])
+def test_RuntimeEffectUniformBuffer_set(uniform_buffer, value):
+    index = uniform_buffer.index('iFloat2')
+    uniform_buffer[index] = value
+    assert list(uniform_buffer[index]) == [1, 2]
+
+def test_RuntimeEffectUniformBuffer_set_invalid(uniform_buffer):
+    with pytest.raises(ValueError):
+        uniform_buffer['iFloat3'] = (1, 2)
+
+def test_RuntimeEffectUniformBuffer_makeShader(uniform_buffer):
+    effect = uniform_buffer.effect()
+    uniform_buffer['iFloat'] = 1.0
+    shader = effect.makeShader(
+        uniform_buffer, [skia.Bitmap().makeShader()])
+    assert isinstance(shader, skia.Shader)
+    snapshot = uniform_buffer.data()
+    uniform_buffer['iFloat'] = 2.0
+    assert snapshot.bytes() != uniform_buffer.data().bytes()
+
+def test_RuntimeEffectUniformBuffer_per_frame(gradient_effect):
+    def address(data):
+        return np.frombuffer(data.data(), dtype=np.uint8).ctypes.data
+
+    uniforms = gradient_effect.makeUniformBuffer()
+    shader = None
+    addresses = []
+    for frame in range(6):
+        # The previous frame's shader is still alive during this write.
+        uniforms['scale'] = frame
+        shader = gradient_effect.makeShader(uniforms)
+        data = uniforms.data()
+        addresses.append(address(data))
+        del data
+    # Writes alternate between two buffers instead of allocating each frame.
+    assert addresses[2:] == addresses[:2] * 2
+    assert addresses[0] != addresses[1]
+
+
+@pytest.fixture(scope='session')
+def gradient_effect():
+    return skia.RuntimeEffect.MakeForShader("""
+uniform float scale;
+vec4 main(vec2 p) { return vec4(p.x * scale, p.y * scale, 0, 1); }""")
+
+@pytest.mark.parametrize('kwargs', [
+    {},
+    {'colorType': skia.ColorType.kRGBA_F32_ColorType},
+    {'threads': 1},
+])
+def test_RuntimeEffect_evaluate(gradient_effect, kwargs):
+    array = gradient_effect.evaluate(16, 8, {'scale': 1 / 16}, **kwargs)
+    assert isinstance(array, np.ndarray)
+    assert array.shape == (8, 16, 4)
+
+def test_RuntimeEffect_evaluate_out(gradient_effect):
+    out = np.zeros((8, 16, 4), dtype=np.float32)
+    uniforms = gradient_effect.makeUniformBuffer()
+    uniforms['scale'] = 1 / 16
+    result = gradient_effect.evaluate(
+        16, 8, uniforms, colorType=skia.ColorType.kRGBA_F32_ColorType,
+        out=out)
+    assert result is out
+    assert out[0, 3, 0] == pytest.approx(3.5 / 16)
+    assert out[5, 0, 1] == pytest.approx(5.5 / 16)
+
+
+def test_RuntimeEffect_cache():
+    sksl = "vec4 main(vec2 p){return vec4(0.25,0,0,1);}"
+    skia.RuntimeEffect.PurgeCache(resetStats=True)
+    first = skia.RuntimeEffect.MakeForShader(sksl)
+    second = skia.RuntimeEffect.MakeForShader(sksl)
+    assert first is second
+    stats = skia.RuntimeEffect.GetCacheStats()
+    assert stats['hits'] == 1
+    assert stats['misses'] == 1
+    assert stats['count'] == 1
+    assert stats['compileTime'] >= 0
+
+def test_RuntimeEffect_cache_limit():
+    template = "vec4 main(vec2 p){return vec4(%d.0/255,0,0,1);}"
+    skia.RuntimeEffect.PurgeCache(resetStats=True)
+    limit = skia.RuntimeEffect.GetCacheStats()['limit']
+    skia.RuntimeEffect.SetCacheLimit(2)
+    try:
+        first = skia.RuntimeEffect.MakeForShader(template % 0)
+        skia.RuntimeEffect.MakeForShader(template % 1)
+        assert skia.RuntimeEffect.MakeForShader(template % 0) is first
+        skia.RuntimeEffect.MakeForShader(template % 2)
+        stats = skia.RuntimeEffect.GetCacheStats()
+        assert stats['count'] == 2
+        assert stats['limit'] == 2
+        assert skia.RuntimeEffect.MakeForShader(template % 0) is first
+        assert skia.RuntimeEffect.GetCacheStats()['misses'] == 3
+        skia.RuntimeEffect.MakeForShader(template % 1)
+        assert skia.RuntimeEffect.GetCacheStats()['misses'] == 4
+    finally:
+        skia.RuntimeEffect.SetCacheLimit(limit)
+
+def test_RuntimeEffect_cache_disabled():
+    sksl = "vec4 main(vec2 p){return vec4(0.5,0,0,1);}"
+    skia.RuntimeEffect.SetCacheEnabled(False)
+    try:
+        assert (skia.RuntimeEffect.MakeForShader(sksl) is not
+                skia.RuntimeEffect.MakeForShader(sksl))
+    finally:
+        skia.RuntimeEffect.SetCacheEnabled(True)
@@ -141,6 +141,39 @@ def test_Surface_asyncRescaleAndReadPixels(surface):
     surface.flushAndSubmit()
 
 
+@pytest.mark.parametrize('threads', [1, 0])
+def test_Surface_readYUV420(threads):
+    surface = skia.Surface(40, 31)
+    surface.getCanvas().clear(0xFF808080)
+    y = np.empty((31, 40), dtype=np.uint8)
+    u = np.empty((16, 20), dtype=np.uint8)
+    v = np.empty((16, 20), dtype=np.uint8)
+    surface.readYUV420(
+        y, u, v, skia.YUVColorSpace.kJPEG_YUVColorSpace, threads=threads)
+    assert np.all(np.abs(y.astype(int) - 128) <= 1)
+    assert np.all(np.abs(u.astype(int) - 128) <= 1)
+    assert np.all(np.abs(v.astype(int) - 128) <= 1)
+    image = skia.Image.FromYUV420Arrays(
+        y, u, v, skia.YUVColorSpace.kJPEG_YUVColorSpace)
+    assert np.all(np.abs(
+        image.toarray().astype(int) - surface.toarray().astype(int)) <= 2)
+
+
+def test_Surface_readYUV420_bounds(surface):
+    y = np.empty((surface.height() + 2, 4), dtype=np.uint8)
+    u = np.empty(((y.shape[0] + 1) // 2, 2), dtype=np.uint8)
+    with pytest.raises(ValueError):
+        surface.readYUV420(y, u, u.copy())
+
+
+def test_Surface_readYUV420_dtype():
+    surface = skia.Surface(4, 4)
+    y = np.empty((4, 4), dtype=np.float32)
+    u = np.empty((2, 2), dtype=np.uint8)
+    with pytest.raises(TypeError):
+        surface.readYUV420(y, u, u.copy())
+
+
 @pytest.mark.skip(reason='m116:REVISIT')
 def test_Surface_asyncRescaleAndReadPixelsYUV420(surface):
     def assert_result(result):
@@ -268,3 +301,48 @@ def test_Surface_MakeRenderTarget_2(context):
 
 def test_Surface_MakeNull():
     check_surface(skia.Surface.MakeNull(100, 100))
+
+
+def test_SurfacePool_acquire():
+    pool = skia.SurfacePool()
+    with pool.acquire(32, 16) as surface:
+        assert isinstance(surface, skia.Surface)
+        assert (surface.width(), surface.height()) == (32, 16)
+        surface.getCanvas().clear(skia.ColorRED)
+    info = skia.ImageInfo.MakeN32Premul(32, 16)
+    with pool.acquire(info) as surface:
+        assert np.all(surface.toarray() == 0)
+    stats = pool.stats()
+    assert stats['hits'] == 1
+    assert stats['misses'] == 1
+    assert stats['count'] == 1
+    assert stats['bytes'] == 32 * 16 * 4
+
+
+def test_SurfacePool_state_reset():
+    pool = skia.SurfacePool()
+    with pool.acquire(8, 8) as surface:
+        canvas = surface.getCanvas()
+        canvas.save()
+        canvas.translate(4, 4)
+    with pool.acquire(8, 8) as surface:
+        assert surface.getCanvas().getSaveCount() == 1
+        assert surface.getCanvas().getTotalMatrix().isIdentity()
+    with pool.acquire(8, 8) as surface:
+        surface.getCanvas().clipRect(skia.Rect(4, 4))
+    assert pool.stats()['count'] == 0
+
+
+def test_SurfacePool_maxBytes():
+    pool = skia.SurfacePool(maxBytes=2 * 8 * 8 * 4)
+    leases = [pool.acquire(8, 8) for _ in range(3)]
+    for lease in leases:
+        lease.release()
+        lease.release()
+    stats = pool.stats()
+    assert stats['count'] == 2
+    assert stats['evictions'] == 1
+    pool.setMaxBytes(0)
+    assert pool.stats()['bytes'] == 0
+    with pytest.raises(RuntimeError):
+        leases[0].surface()
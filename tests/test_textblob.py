@@ -1,5 +1,6 @@
 import skia
 import pytest
+import numpy as np
 
 
 @pytest.fixture
@@ -70,6 +71,40 @@ def test_TextBlob_MakeFromRSXform():
         skia.TextBlob.MakeFromRSXform('foo', xform, skia.Font()), skia.TextBlob)
 
 
+@pytest.mark.parametrize('positions, run_offsets', [
+    (np.zeros((4, 2), dtype=np.float32), None),
+    (np.zeros((4, 2), dtype=np.float32), [0, 2]),
+    (np.tile(np.array([1, 0, 0, 0], dtype=np.float32), (4, 1)), [0, 1, 4]),
+])
+def test_TextBlob_MakeFromArrays(positions, run_offsets):
+    glyphs = np.array([36, 37, 38, 39], dtype=np.uint16)
+    blob = skia.TextBlob.MakeFromArrays(
+        skia.Font(), glyphs, positions, run_offsets)
+    assert isinstance(blob, skia.TextBlob)
+    assert [run.fGlyphIndices for run in blob][0][0] == 36
+    assert sum(run.fGlyphCount for run in blob) == 4
+
+
+def test_TextBlob_MakeFromArrays_invalid():
+    glyphs = np.array([36, 37], dtype=np.uint16)
+    with pytest.raises(ValueError):
+        skia.TextBlob.MakeFromArrays(
+            skia.Font(), glyphs, np.zeros((2, 3), dtype=np.float32))
+    with pytest.raises(ValueError):
+        skia.TextBlob.MakeFromArrays(
+            skia.Font(), glyphs, np.zeros((2, 2), dtype=np.float32), [1])
+
+
+def test_TextBlob_MakeOnPath():
+    path = skia.Path()
+    path.moveTo(0, 0)
+    path.lineTo(100, 0)
+    blob = skia.TextBlob.MakeOnPath('foo', path, skia.Font())
+    assert isinstance(blob, skia.TextBlob)
+    assert sum(run.fGlyphCount for run in blob) == 3
+    assert skia.TextBlob.MakeOnPath('foo', skia.Path(), skia.Font()) is None
+
+
 def test_TexbBlob_Deserialize(textblob):
     data = textblob.serialize()
     assert isinstance(skia.TextBlob.Deserialize(data), skia.TextBlob)
@@ -0,0 +1,58 @@
+import skia
+import pytest
+import json
+
+
+@pytest.fixture
+def tracing():
+    yield skia.tracing
+    if skia.tracing.isEnabled():
+        skia.tracing.stop()
+
+
+def test_tracing_start_stop(tracing):
+    tracing.start()
+    assert tracing.isEnabled()
+    surface = skia.Surface(64, 64)
+    with surface as canvas:
+        canvas.drawCircle(32, 32, 16, skia.Paint())
+    trace = json.loads(tracing.stop())
+    assert not tracing.isEnabled()
+    assert isinstance(trace['traceEvents'], list)
+    for event in trace['traceEvents']:
+        assert {'name', 'cat', 'ph', 'ts', 'pid', 'tid'} <= set(event)
+
+
+def draw_traced(tracing, *args):
+    tracing.start(*args)
+    surface = skia.Surface(64, 64)
+    with surface as canvas:
+        canvas.drawCircle(32, 32, 16, skia.Paint())
+    return json.loads(tracing.stop())['traceEvents']
+
+
+@pytest.mark.parametrize('categories', ['skia,skia.gpu', ['skia*']])
+def test_tracing_start_categories(tracing, categories):
+    if not draw_traced(tracing):
+        pytest.skip('Skia is built without tracing')
+    events = draw_traced(tracing, categories)
+    assert events
+    assert all(event['cat'].startswith('skia') for event in events)
+
+
+@pytest.mark.parametrize('categories', [None, ['d*'], ['*', 'di*']])
+def test_tracing_start_disabled_by_default(tracing, categories):
+    events = draw_traced(tracing, categories)
+    assert not any(
+        event['cat'].startswith('disabled-by-default-') for event in events)
+
+
+def test_tracing_start_twice(tracing):
+    tracing.start()
+    with pytest.raises(RuntimeError):
+        tracing.start()
+
+
+def test_tracing_stop_without_start(tracing):
+    with pytest.raises(RuntimeError):
+        tracing.stop()
@@ -1,5 +1,6 @@
 import skia
 import pytest
+import numpy as np
 
 
 def test_Vertices_init(vertices):
@@ -39,3 +40,35 @@ def test_Vertices_approximateSize(vertices):
 ])
 def test_Vertices_MakeCopy(args):
     assert isinstance(skia.Vertices.MakeCopy(*args), skia.Vertices)
+
+
+def test_Vertices_MakeFromArrays():
+    positions = np.array([[0, 0], [10, 0], [10, 10], [0, 10]], dtype=np.float32)
+    colors = np.full(4, 0xFFFF0000, dtype=np.uint32)
+    indices = np.array([0, 1, 2, 0, 2, 3])
+    chunks = skia.Vertices.MakeFromArrays(
+        skia.Vertices.kTriangles_VertexMode, positions, positions, colors,
+        indices)
+    assert len(chunks) == 1
+    assert chunks[0].bounds() == skia.Rect(0, 0, 10, 10)
+
+
+def test_Vertices_MakeFromArrays_chunks():
+    n = 200000
+    positions = np.random.rand(n, 2).astype(np.float32) * 100
+    indices = np.random.randint(0, n, size=3 * 100000).astype(np.uint32)
+    chunks = skia.Vertices.MakeFromArrays(
+        skia.Vertices.kTriangles_VertexMode, positions, indices=indices)
+    assert len(chunks) > 1
+    assert all(isinstance(chunk, skia.Vertices) for chunk in chunks)
+
+
+def test_Vertices_MakeFromArrays_errors():
+    positions = np.zeros((3, 2), dtype=np.float32)
+    with pytest.raises(ValueError):
+        skia.Vertices.MakeFromArrays(
+            skia.Vertices.kTriangles_VertexMode, np.zeros((3, 3)))
+    with pytest.raises(IndexError):
+        skia.Vertices.MakeFromArrays(
+            skia.Vertices.kTriangles_VertexMode, positions,
+            indices=[0, 1, 3])